@@ -966,6 +966,24 @@ DART_EXPORT void Dart_NotifyIdle(int64_t deadline);
  */
 DART_EXPORT void Dart_NotifyLowMemory();
 
+/**
+ * Sets goals for the heap of the current isolate. The VM sizes the new and
+ * old generations, starts concurrent marking and decides whether to compact
+ * so as to meet them. Pass 0 for any goal that should not apply.
+ *
+ * \param max_pause_micros The longest acceptable GC pause in microseconds.
+ * \param heap_limit_percent The combined capacity of both generations as a
+ *   percentage of the memory available to the process, which is the cgroup
+ *   memory limit when running in a container and physical memory otherwise.
+ * \param gc_time_percent The share of run time that may be spent in GC
+ *   before the heap grows more aggressively.
+ *
+ * Requires there to be a current isolate.
+ */
+DART_EXPORT void Dart_SetHeapGoals(int64_t max_pause_micros,
+                                   intptr_t heap_limit_percent,
+                                   intptr_t gc_time_percent);
+
 /**
  * Starts the CPU sampling profiler.
  */
@@ -268,6 +268,26 @@ DART_EXPORT Dart_Handle Dart_ServiceSendDataEvent(const char* stream_id,
                                                   const uint8_t* bytes,
                                                   intptr_t bytes_length);
 
+/**
+ * Writes a heap snapshot of the current isolate in the format of the
+ * service protocol's _Graph events.
+ *
+ * Unlike the service request, the snapshot is not accumulated in memory:
+ * it is handed to 'callback' in fixed-size chunks while the heap is walked,
+ * so it is suitable for large heaps in production. A full garbage collection
+ * is performed first. The callback must not call back into the VM.
+ *
+ * \param callback Receives each chunk of the snapshot, e.g. to write it to a
+ *   file descriptor.
+ * \param callback_data Passed as the first argument to 'callback'.
+ *
+ * \return Success if the snapshot was written. Otherwise, returns an error
+ *   handle.
+ */
+DART_EXPORT Dart_Handle
+Dart_WriteHeapSnapshot(Dart_StreamingWriteCallback callback,
+                       void* callback_data);
+
 /*
  * ========
  * Reload support
@@ -388,6 +408,119 @@ DART_EXPORT void Dart_TimelineEvent(const char* label,
  */
 DART_EXPORT void Dart_SetThreadName(const char* name);
 
+/*
+ * =========
+ * Profiling
+ * =========
+ */
+
+/**
+ * The kinds of samples that can be exported with Dart_WriteProfile.
+ */
+typedef enum {
+  /** CPU samples of the current isolate's mutator thread. */
+  Dart_ProfileKind_CPU = 0,
+  /** Dart heap allocation samples of the current isolate. */
+  Dart_ProfileKind_Allocation,
+  /** Native (malloc) allocation samples that have not yet been freed. */
+  Dart_ProfileKind_NativeAllocation,
+} Dart_ProfileKind;
+
+/**
+ * Writes the samples recorded by the profiler as an uncompressed pprof
+ * profile (profile.proto). Samples with identical stacks are merged, and
+ * every function is written once.
+ *
+ * Embedders doing continuous profiling can call this periodically, passing
+ * the end of the previous time range as the origin of the next one.
+ *
+ * \param kind The kind of samples to export.
+ * \param time_origin_micros Start of the time range, or -1 for all samples.
+ * \param time_extent_micros Length of the time range, or -1 for all samples.
+ * \param callback Receives the encoded profile.
+ * \param callback_data Passed as the first argument to 'callback'.
+ *
+ * \return Success if the profile was written. Otherwise, for example when
+ *   the profiler is disabled, returns an error handle.
+ */
+DART_EXPORT Dart_Handle Dart_WriteProfile(Dart_ProfileKind kind,
+                                          int64_t time_origin_micros,
+                                          int64_t time_extent_micros,
+                                          Dart_StreamingWriteCallback callback,
+                                          void* callback_data);
+
+/*
+ * ============
+ * GC Telemetry
+ * ============
+ */
+
+/**
+ * A named duration or count reported for one garbage collection.
+ */
+typedef struct {
+  const char* name;
+  int64_t value;
+} Dart_GCMetric;
+
+/**
+ * The work done by one GC helper task, such as a marker or compactor.
+ */
+typedef struct {
+  /** The kind of task, e.g. "ParallelMark", "ConcurrentMark", "Compact". */
+  const char* name;
+  /** The OS thread the task ran on. */
+  int64_t thread_id;
+  int64_t micros;
+  /** Bytes marked or moved by the task. */
+  int64_t bytes;
+} Dart_GCTask;
+
+/**
+ * Describes one completed garbage collection. All pointers are only valid
+ * for the duration of the callback.
+ */
+typedef struct {
+  const char* isolate_name;
+  /** "Scavenge", "MarkSweep" or "MarkCompact". */
+  const char* type;
+  const char* reason;
+  /** Monotonic timestamps, comparable with Dart_TimelineGetMicros. */
+  int64_t start_micros;
+  int64_t end_micros;
+  /**
+   * Time spent in each phase in microseconds. Phases that did not run are
+   * omitted, and a phase may contain others (e.g. "Marking" includes
+   * "WeakHandles").
+   */
+  intptr_t num_phases;
+  const Dart_GCMetric* phases;
+  /** Work counters such as "BytesPromoted" or "CardsScanned". */
+  intptr_t num_counters;
+  const Dart_GCMetric* counters;
+  /**
+   * Helper tasks that contributed to this collection. For a mark-sweep this
+   * includes the concurrent marking tasks that ran since the previous one.
+   */
+  intptr_t num_tasks;
+  const Dart_GCTask* tasks;
+} Dart_GCEvent;
+
+/**
+ * Called on the thread that performed a garbage collection, right after it
+ * finishes. The callback must not call back into the VM and should return
+ * quickly, e.g. by copying the event into a ring buffer.
+ */
+typedef void (*Dart_GCEventCallback)(const Dart_GCEvent* event);
+
+/**
+ * Registers a callback that receives per-phase timings, work counters and a
+ * per-task breakdown of every garbage collection in every isolate. Passing
+ * NULL stops the stream. Collecting the data is cheap and always on; events
+ * are only built when a callback is registered.
+ */
+DART_EXPORT void Dart_SetGCEventCallback(Dart_GCEventCallback callback);
+
 /*
  * =======
  * Metrics
@@ -0,0 +1,42 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Verify that doubles stored in unboxed fields can be mutated after the
+// app-jit snapshot is loaded without affecting other instances or constants.
+
+import 'package:expect/expect.dart';
+
+class Box {
+  double value;
+  Box(this.value);
+}
+
+const double kInitial = 1.5;
+
+// Instances created while training end up in the app-jit snapshot together
+// with the boxes of their unboxed double fields.
+final boxes = <Box>[new Box(kInitial), new Box(kInitial)];
+
+void store(Box b, double v) {
+  b.value = v;
+}
+
+double sum(Box a, Box b) => a.value + b.value;
+
+void main(List<String> args) {
+  final isTraining = args.contains("--train");
+  final a = boxes[0];
+  final b = boxes[1];
+  for (var i = 0; i < 20000; i++) {
+    store(a, kInitial);
+    Expect.equals(3.0, sum(a, b));
+  }
+  store(a, 42.0);
+  Expect.equals(42.0, a.value);
+  Expect.equals(kInitial, b.value);
+  Expect.equals(1.5, kInitial);
+  Expect.equals(43.5, sum(a, b));
+  store(a, kInitial);
+  print(isTraining ? 'OK(Trained)' : 'OK(Run)');
+}
@@ -0,0 +1,143 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Calls to selectors with more implementations than exhaustive class checks
+// handle are dispatched through the global dispatch table in AOT. Verify that
+// such calls reach the right method, getter and setter for every receiver
+// class, including inherited implementations and noSuchMethod forwarders.
+
+import "package:expect/expect.dart";
+
+abstract class Shape {
+  int _value = 0;
+
+  String name();
+  int get sides;
+  set value(int v);
+
+  int get value => _value;
+
+  // Calls through 'this' have a receiver of a known class.
+  String describe() => '${name()}:$sides';
+  void update(int v) {
+    value = v;
+  }
+}
+
+class Triangle extends Shape {
+  String name() => 'triangle';
+  int get sides => 3;
+  set value(int v) {
+    _value = v + 3;
+  }
+}
+
+class Square extends Shape {
+  String name() => 'square';
+  int get sides => 4;
+  set value(int v) {
+    _value = v + 4;
+  }
+}
+
+class Pentagon extends Shape {
+  String name() => 'pentagon';
+  int get sides => 5;
+  set value(int v) {
+    _value = v + 5;
+  }
+}
+
+class Hexagon extends Shape {
+  String name() => 'hexagon';
+  int get sides => 6;
+  set value(int v) {
+    _value = v + 6;
+  }
+}
+
+class Heptagon extends Shape {
+  String name() => 'heptagon';
+  int get sides => 7;
+  set value(int v) {
+    _value = v + 7;
+  }
+}
+
+class Octagon extends Shape {
+  String name() => 'octagon';
+  int get sides => 8;
+  set value(int v) {
+    _value = v + 8;
+  }
+}
+
+// Inherits every member from Square.
+class Rectangle extends Square {}
+
+// Overrides only the getter.
+class Rhombus extends Square {
+  int get sides => 40;
+}
+
+// Implements the abstract members through noSuchMethod forwarders.
+class Ghost extends Shape {
+  noSuchMethod(Invocation invocation) {
+    if (invocation.memberName == #name) return 'ghost';
+    if (invocation.memberName == #sides) return 0;
+    if (invocation.isSetter) {
+      _value = -1;
+      return null;
+    }
+    return super.noSuchMethod(invocation);
+  }
+}
+
+List<Shape> makeShapes() => <Shape>[
+      new Triangle(),
+      new Square(),
+      new Pentagon(),
+      new Hexagon(),
+      new Heptagon(),
+      new Octagon(),
+      new Rectangle(),
+      new Rhombus(),
+      new Ghost(),
+    ];
+
+const expectedNames = const <String>[
+  'triangle',
+  'square',
+  'pentagon',
+  'hexagon',
+  'heptagon',
+  'octagon',
+  'square',
+  'square',
+  'ghost',
+];
+
+const expectedSides = const <int>[3, 4, 5, 6, 7, 8, 4, 40, 0];
+
+const expectedValues = const <int>[13, 14, 15, 16, 17, 18, 14, 14, -1];
+
+void test() {
+  final shapes = makeShapes();
+  for (int i = 0; i < shapes.length; i++) {
+    final Shape shape = shapes[i];
+    Expect.equals(expectedNames[i], shape.name());
+    Expect.equals(expectedSides[i], shape.sides);
+    Expect.equals('${expectedNames[i]}:${expectedSides[i]}', shape.describe());
+    shape.update(10);
+    Expect.equals(expectedValues[i], shape.value);
+    shape.value = 10;
+    Expect.equals(expectedValues[i], shape.value);
+  }
+}
+
+main() {
+  for (int i = 0; i < 100; i++) {
+    test();
+  }
+}
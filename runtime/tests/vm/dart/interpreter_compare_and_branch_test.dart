@@ -0,0 +1,118 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--no-background-compilation
+// VMOptions=--optimization_counter_threshold=10 --no-background-compilation
+
+// Verify that int comparisons, null checks and boolean negation give the
+// same answers whether their result is consumed directly by a conditional
+// jump or materialized as a bool. The bytecode interpreter fuses the first
+// form into the comparison.
+
+import "package:expect/expect.dart";
+
+const int kBig = 0x7fffffffffffffff;
+const int kSmall = -0x8000000000000000;
+
+String branchOn(int a, int b) {
+  final sb = new StringBuffer();
+  if (a == b) sb.write('eq ');
+  if (a != b) sb.write('ne ');
+  if (a < b) sb.write('lt ');
+  if (a > b) sb.write('gt ');
+  if (a <= b) sb.write('le ');
+  if (a >= b) sb.write('ge ');
+  return sb.toString();
+}
+
+String valueOf(int a, int b) {
+  final bool eq = a == b;
+  final bool ne = a != b;
+  final bool lt = a < b;
+  final bool gt = a > b;
+  final bool le = a <= b;
+  final bool ge = a >= b;
+  return '$eq $ne $lt $gt $le $ge';
+}
+
+String expectedValueOf(String branches) {
+  final parts = ['eq', 'ne', 'lt', 'gt', 'le', 'ge'];
+  return parts.map((p) => branches.contains('$p ')).join(' ');
+}
+
+bool isNullBranch(Object o) {
+  if (o == null) {
+    return true;
+  }
+  return false;
+}
+
+bool isNullValue(Object o) => o == null;
+
+bool notBranch(bool b) {
+  if (!b) {
+    return true;
+  }
+  return false;
+}
+
+bool notValue(bool b) => !b;
+
+bool shortCircuit(int a, int b, int c) => a < b && !(b > c) || a == c;
+
+int countUp(int limit) {
+  int n = 0;
+  for (int i = 0; i < limit; i++) {
+    n++;
+  }
+  int j = limit;
+  while (j >= 1) {
+    n++;
+    j--;
+  }
+  return n;
+}
+
+void testCompare(int a, int b, String expected) {
+  Expect.equals(expected, branchOn(a, b), '$a vs $b');
+  Expect.equals(expectedValueOf(expected), valueOf(a, b), '$a vs $b');
+}
+
+void test() {
+  testCompare(1, 1, 'eq le ge ');
+  testCompare(1, 2, 'ne lt le ');
+  testCompare(2, 1, 'ne gt ge ');
+  testCompare(-1, 1, 'ne lt le ');
+  testCompare(kBig, kBig, 'eq le ge ');
+  testCompare(kBig, kSmall, 'ne gt ge ');
+  testCompare(kSmall, kBig, 'ne lt le ');
+  testCompare(kBig - 1, kBig, 'ne lt le ');
+  testCompare(kBig, 0, 'ne gt ge ');
+
+  Expect.isTrue(isNullBranch(null));
+  Expect.isFalse(isNullBranch(0));
+  Expect.isFalse(isNullBranch('x'));
+  Expect.isTrue(isNullValue(null));
+  Expect.isFalse(isNullValue(0));
+
+  Expect.isTrue(notBranch(false));
+  Expect.isFalse(notBranch(true));
+  Expect.isTrue(notValue(false));
+  Expect.isFalse(notValue(true));
+
+  Expect.isTrue(shortCircuit(1, 2, 3));
+  Expect.isFalse(shortCircuit(1, 3, 2));
+  Expect.isTrue(shortCircuit(2, 1, 2));
+  Expect.isFalse(shortCircuit(3, 2, 1));
+
+  Expect.equals(0, countUp(0));
+  Expect.equals(2, countUp(1));
+  Expect.equals(20, countUp(10));
+}
+
+main() {
+  for (int i = 0; i < 20; i++) {
+    test();
+  }
+}
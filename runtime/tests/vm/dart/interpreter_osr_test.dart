@@ -0,0 +1,102 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Test that activations of interpreted functions with hot loops are moved
+// into optimized code (on-stack replacement) without changing their results.
+
+// VMOptions=--optimization_counter_threshold=100 --no-background-compilation
+// VMOptions=--optimization_counter_threshold=100 --no-background-compilation --enable-interpreter --compilation_counter_threshold=10
+
+import "package:expect/expect.dart";
+
+class Box {
+  var value;
+  Box(this.value);
+}
+
+int sumTo(int n) {
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    sum += i;
+  }
+  return sum;
+}
+
+int nested(int n, Box box) {
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < 10; j++) {
+      sum += box.value;
+    }
+  }
+  return sum;
+}
+
+num changingTypes(int n) {
+  num sum = 0;
+  for (int i = 0; i < n; i++) {
+    // Deoptimizes the OSR code once the loop switches to doubles.
+    sum += (i < n ~/ 2) ? i : 0.5;
+  }
+  return sum;
+}
+
+int withOptional(int n, [int step = 1, int start = 0]) {
+  int sum = start;
+  for (int i = 0; i < n; i += step) {
+    sum += i;
+  }
+  return sum;
+}
+
+List<T> generic<T>(int n, T value) {
+  final list = <T>[];
+  for (int i = 0; i < n; i++) {
+    list.add(value);
+  }
+  return list;
+}
+
+int withCapture(int n) {
+  int sum = 0;
+  final add = (int x) => sum += x;
+  for (int i = 0; i < n; i++) {
+    add(i);
+  }
+  return sum;
+}
+
+int catchInLoop(int n) {
+  int caught = 0;
+  for (int i = 0; i < n; i++) {
+    try {
+      if (i % 1000 == 0) throw i;
+    } catch (e) {
+      caught += e;
+    }
+  }
+  return caught;
+}
+
+void throwAfterLoop(int n) {
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    sum += i;
+  }
+  throw sum;
+}
+
+main() {
+  Expect.equals(49995000, sumTo(10000));
+  Expect.equals(300000, nested(10000, new Box(3)));
+  Expect.equals(1250000000.0, changingTypes(100000));
+  Expect.equals(49995000, withOptional(10000));
+  Expect.equals(24995000 + 7, withOptional(10000, 2, 7));
+  final list = generic<String>(10000, "a");
+  Expect.equals(10000, list.length);
+  Expect.isTrue(list is List<String>);
+  Expect.equals(49995000, withCapture(10000));
+  Expect.equals(4950000, catchInLoop(100000));
+  Expect.throws(() => throwAfterLoop(10000), (e) => e == 49995000);
+}
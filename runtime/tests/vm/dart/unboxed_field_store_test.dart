@@ -0,0 +1,99 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--optimization_counter_threshold=10 --no-use-osr --no-background-compilation
+
+// Verify that storing into an unboxed double or SIMD field after
+// construction only changes that instance. The fields always hold non-null
+// values, so they are also unboxed in AOT where type flow analysis infers
+// their types. Stores must not write into a box shared with another
+// instance or with a constant, and values read before a store keep their
+// value.
+
+import 'dart:typed_data';
+
+import "package:expect/expect.dart";
+
+const double kDouble = 1.5;
+final Float32x4 kFloat32x4 = new Float32x4(1.0, 2.0, 3.0, 4.0);
+final Float64x2 kFloat64x2 = new Float64x2(1.0, 2.0);
+
+class Holder {
+  double d;
+  Float32x4 f32x4;
+  Float64x2 f64x2;
+
+  Holder(this.d, this.f32x4, this.f64x2);
+
+  Holder.copy(Holder other)
+      : d = other.d,
+        f32x4 = other.f32x4,
+        f64x2 = other.f64x2;
+}
+
+void store(Holder h, double d, Float32x4 f32x4, Float64x2 f64x2) {
+  h.d = d;
+  h.f32x4 = f32x4;
+  h.f64x2 = f64x2;
+}
+
+// Dynamic calls go through the implicit getters.
+List readDynamic(dynamic h) => [h.d, h.f32x4, h.f64x2];
+
+void expectInitial(Holder h) {
+  Expect.equals(kDouble, h.d);
+  Expect.equals(1.0, h.f32x4.x);
+  Expect.equals(4.0, h.f32x4.w);
+  Expect.equals(1.0, h.f64x2.x);
+  Expect.equals(2.0, h.f64x2.y);
+}
+
+void expectInitialValues(double d, Float32x4 f32x4, Float64x2 f64x2) {
+  Expect.equals(kDouble, d);
+  Expect.equals(1.0, f32x4.x);
+  Expect.equals(4.0, f32x4.w);
+  Expect.equals(1.0, f64x2.x);
+  Expect.equals(2.0, f64x2.y);
+}
+
+void main() {
+  for (int i = 0; i < 100; i++) {
+    final a = new Holder(kDouble, kFloat32x4, kFloat64x2);
+    final b = new Holder(kDouble, kFloat32x4, kFloat64x2);
+    final c = new Holder.copy(a);
+
+    store(a, i + 0.5, new Float32x4(-1.0, -2.0, -3.0, i.toDouble()),
+        new Float64x2(-1.0, i.toDouble()));
+
+    Expect.equals(i + 0.5, a.d);
+    Expect.equals(-1.0, a.f32x4.x);
+    Expect.equals(i.toDouble(), a.f32x4.w);
+    Expect.equals(-1.0, a.f64x2.x);
+    Expect.equals(i.toDouble(), a.f64x2.y);
+
+    // Neither the other instances nor the values they were initialized from
+    // may observe the store.
+    expectInitial(b);
+    expectInitial(c);
+    Expect.equals(1.5, kDouble);
+    Expect.equals(1.0, kFloat32x4.x);
+    Expect.equals(4.0, kFloat32x4.w);
+    Expect.equals(1.0, kFloat64x2.x);
+    Expect.equals(2.0, kFloat64x2.y);
+
+    // Values read before a store to the same field are not changed by it.
+    final e = new Holder(kDouble, kFloat32x4, kFloat64x2);
+    final double d = e.d;
+    final Float32x4 f32x4 = e.f32x4;
+    final Float64x2 f64x2 = e.f64x2;
+    final List values = readDynamic(e);
+    store(e, 2.0, new Float32x4(-1.0, -2.0, -3.0, -4.0),
+        new Float64x2(-1.0, -2.0));
+    expectInitialValues(d, f32x4, f64x2);
+    expectInitialValues(values[0], values[1], values[2]);
+    Expect.equals(2.0, e.d);
+    Expect.equals(-4.0, e.f32x4.w);
+    Expect.equals(-2.0, e.f64x2.y);
+  }
+}
@@ -0,0 +1,87 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--concurrent_mark --optimization_counter_threshold=10 --no-background-compilation
+// VMOptions=--concurrent_mark --marker_tasks=0 --optimization_counter_threshold=10 --no-background-compilation
+
+// Initializing stores into freshly allocated objects and list literals skip
+// the write barrier, also when the initialization is split by control flow.
+// Verify that objects reachable only through such stores survive while
+// old-space marking runs concurrently with the mutator.
+
+import "package:expect/expect.dart";
+
+class Box {
+  final int value;
+  Box(this.value);
+}
+
+class Node {
+  Box first;
+  Box second;
+  Box third;
+  Node next;
+
+  Node(Box a, Box b, Node next)
+      : first = a,
+        second = b == null ? a : b,
+        third = next == null ? new Box(-1) : next.first,
+        next = next;
+}
+
+// Long-lived boxes; they are promoted to old space and are still unmarked
+// when a marking cycle starts.
+final List<Box> oldBoxes = new List<Box>.generate(1000, (i) => new Box(i));
+
+Node buildNode(int i, Node next) {
+  final Box a = oldBoxes[i % oldBoxes.length];
+  final Box b = i.isEven ? new Box(i) : null;
+  return new Node(a, b, next);
+}
+
+List buildList(int i) => [
+      oldBoxes[i % oldBoxes.length],
+      i.isEven ? new Box(i) : oldBoxes[(i + 1) % oldBoxes.length],
+      new Box(-i),
+    ];
+
+void checkNode(Node node, int i) {
+  Expect.equals(i % oldBoxes.length, node.first.value);
+  Expect.equals(i.isEven ? i : i % oldBoxes.length, node.second.value);
+  Expect.equals(i == 0 ? -1 : (i - 1) % oldBoxes.length, node.third.value);
+}
+
+void checkList(List list, int i) {
+  Expect.equals(i % oldBoxes.length, list[0].value);
+  Expect.equals(
+      i.isEven ? i : (i + 1) % oldBoxes.length, (list[1] as Box).value);
+  Expect.equals(-i, list[2].value);
+}
+
+main() {
+  const int kRounds = 20;
+  const int kPerRound = 20000;
+  final List<List> retained = <List>[];
+  for (int round = 0; round < kRounds; round++) {
+    Node head = null;
+    final List lists = new List(kPerRound);
+    for (int i = 0; i < kPerRound; i++) {
+      head = buildNode(i, head);
+      lists[i] = buildList(i);
+      // Old-space garbage keeps the concurrent marker busy.
+      if (i % 64 == 0) {
+        retained.add(new List(1000));
+        if (retained.length > 200) {
+          retained.removeRange(0, 100);
+        }
+      }
+    }
+    for (int i = kPerRound - 1; i >= 0; i--) {
+      checkNode(head, i);
+      checkList(lists[i], i);
+      head = head.next;
+    }
+    Expect.isNull(head);
+  }
+}
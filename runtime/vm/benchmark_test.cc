@@ -22,6 +22,8 @@ using dart::bin::File;
 
 namespace dart {
 
+DECLARE_FLAG(int, pretenure_threshold);
+
 Benchmark* Benchmark::first_ = NULL;
 Benchmark* Benchmark::tail_ = NULL;
 const char* Benchmark::executable_ = NULL;
@@ -750,6 +752,63 @@ BENCHMARK(LargeMap) {
   benchmark->set_score(elapsed_time);
 }
 
+//
+// Measure allocation of objects that outlive several scavenges, with and
+// without pretenuring them.
+//
+static void RunRetainedAllocation(Benchmark* benchmark,
+                                  int pretenure_threshold,
+                                  const char* name) {
+  const char* kScriptChars =
+      "class Node {\n"
+      "  final next;\n"
+      "  final value;\n"
+      "  Node(this.next, this.value);\n"
+      "}\n"
+      "build(int length) {\n"
+      "  var head;\n"
+      "  for (int i = 0; i < length; i++) {\n"
+      "    head = new Node(head, i);\n"
+      "  }\n"
+      "  return head;\n"
+      "}\n"
+      "benchmark(int rounds) {\n"
+      "  var list;\n"
+      "  for (int i = 0; i < rounds; i++) {\n"
+      "    list = build(200000);\n"
+      "  }\n"
+      "  return list.value;\n"
+      "}\n";
+  // Set before the allocation stub of Node is generated, see
+  // target::Class::MayBePretenured.
+  SetFlagScope<int> sfs(&FLAG_pretenure_threshold, pretenure_threshold);
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(20);
+
+  // Warmup first to avoid compilation jitters. This also gives the scavenger
+  // the chance to pretenure Node.
+  Dart_Handle result = Dart_Invoke(lib, NewString("benchmark"), 1, args);
+  EXPECT_VALID(result);
+
+  Timer timer(true, name);
+  timer.Start();
+  result = Dart_Invoke(lib, NewString("benchmark"), 1, args);
+  EXPECT_VALID(result);
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
+BENCHMARK(RetainedAllocation) {
+  RunRetainedAllocation(benchmark, 0, "Retained allocation");
+}
+
+BENCHMARK(RetainedAllocationPretenured) {
+  RunRetainedAllocation(benchmark, 90, "Retained allocation, pretenured");
+}
+
 BENCHMARK_MEMORY(InitialRSS) {
   benchmark->set_score(bin::Process::MaxRSS());
 }
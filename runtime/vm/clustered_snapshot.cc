@@ -5,18 +5,21 @@
 #include "vm/clustered_snapshot.h"
 
 #include "platform/assert.h"
+#include "platform/atomic.h"
 #include "vm/bootstrap.h"
 #include "vm/compiler/backend/code_statistics.h"
 #include "vm/compiler/relocation.h"
 #include "vm/dart.h"
 #include "vm/heap/heap.h"
 #include "vm/image_snapshot.h"
+#include "vm/lockers.h"
 #include "vm/native_entry.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/program_visitor.h"
 #include "vm/stub_code.h"
 #include "vm/symbols.h"
+#include "vm/thread_pool.h"
 #include "vm/timeline.h"
 #include "vm/version.h"
 
@@ -200,6 +203,9 @@ class ClassDeserializationCluster : public DeserializationCluster {
   ClassDeserializationCluster() {}
   ~ClassDeserializationCluster() {}
 
+  // Filling registers the classes in the class table.
+  bool CanFillConcurrently() const { return false; }
+
   void ReadAlloc(Deserializer* d) {
     predefined_start_index_ = d->next_index();
     PageSpace* old_space = d->heap()->old_space();
@@ -1749,7 +1755,7 @@ class ObjectPoolDeserializationCluster : public DeserializationCluster {
 };
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
-// PcDescriptor, StackMap, OneByteString, TwoByteString
+// PcDescriptor, StackMap, OneByteString, TwoByteString, canonical Double
 class RODataSerializationCluster : public SerializationCluster {
  public:
   RODataSerializationCluster(const char* name, intptr_t cid)
@@ -1777,6 +1783,10 @@ class RODataSerializationCluster : public SerializationCluster {
 
   void WriteAlloc(Serializer* s) {
     s->WriteCid(cid_);
+    WriteAllocObjects(s);
+  }
+
+  void WriteAllocObjects(Serializer* s) {
     intptr_t count = shared_objects_.length();
     s->WriteUnsigned(count);
     for (intptr_t i = 0; i < count; i++) {
@@ -3171,16 +3181,28 @@ class MintDeserializationCluster : public DeserializationCluster {
 #if !defined(DART_PRECOMPILED_RUNTIME)
 class DoubleSerializationCluster : public SerializationCluster {
  public:
-  DoubleSerializationCluster() : SerializationCluster("double") {}
+  DoubleSerializationCluster()
+      : SerializationCluster("double"),
+        ro_cluster_("(RO)Double", kDoubleCid) {}
   ~DoubleSerializationCluster() {}
 
   void Trace(Serializer* s, RawObject* object) {
     RawDouble* dbl = Double::RawCast(object);
-    objects_.Add(dbl);
+    // Only canonical doubles of AOT snapshots are mapped from the read-only
+    // data image. Other doubles may be the mutable boxes of unboxed fields,
+    // which compiled code writes into.
+    if ((s->kind() == Snapshot::kFullAOT) && dbl->IsCanonical()) {
+      ro_cluster_.Trace(s, dbl);
+    } else {
+      objects_.Add(dbl);
+    }
   }
 
   void WriteAlloc(Serializer* s) {
     s->WriteCid(kDoubleCid);
+    if (s->kind() == Snapshot::kFullAOT) {
+      ro_cluster_.WriteAllocObjects(s);
+    }
     intptr_t count = objects_.length();
     s->WriteUnsigned(count);
     for (intptr_t i = 0; i < count; i++) {
@@ -3200,6 +3222,7 @@ class DoubleSerializationCluster : public SerializationCluster {
   }
 
  private:
+  RODataSerializationCluster ro_cluster_;
   GrowableArray<RawDouble*> objects_;
 };
 #endif  // !DART_PRECOMPILED_RUNTIME
@@ -3210,6 +3233,9 @@ class DoubleDeserializationCluster : public DeserializationCluster {
   ~DoubleDeserializationCluster() {}
 
   void ReadAlloc(Deserializer* d) {
+    if (d->kind() == Snapshot::kFullAOT) {
+      ro_cluster_.ReadAlloc(d);
+    }
     start_index_ = d->next_index();
     PageSpace* old_space = d->heap()->old_space();
     intptr_t count = d->ReadUnsigned();
@@ -3228,6 +3254,9 @@ class DoubleDeserializationCluster : public DeserializationCluster {
       dbl->ptr()->value_ = d->Read<double>();
     }
   }
+
+ private:
+  RODataDeserializationCluster ro_cluster_;
 };
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
@@ -3726,6 +3755,9 @@ class LinkedHashMapDeserializationCluster : public DeserializationCluster {
   LinkedHashMapDeserializationCluster() {}
   ~LinkedHashMapDeserializationCluster() {}
 
+  // Filling allocates the maps' data arrays.
+  bool CanFillConcurrently() const { return false; }
+
   void ReadAlloc(Deserializer* d) {
     start_index_ = d->next_index();
     PageSpace* old_space = d->heap()->old_space();
@@ -4538,15 +4570,34 @@ void Serializer::Serialize() {
   // We should have assigned a ref to every object we pushed.
   ASSERT((next_ref_index_ - 1) == num_objects);
 
+  // Reserve the fill table: the position of each cluster's fill data followed
+  // by the position of the end of the fill section. It is filled in below.
+  const intptr_t fill_table_position = bytes_written();
+  GrowableArray<uint32_t> fill_positions(num_clusters + 1);
+  for (intptr_t i = 0; i <= num_clusters; i++) {
+    fill_positions.Add(0);
+  }
+  WriteBytes(reinterpret_cast<const uint8_t*>(fill_positions.data()),
+             fill_positions.length() * sizeof(uint32_t));
+
+  intptr_t cluster_index = 0;
   for (intptr_t cid = 1; cid < num_cids_; cid++) {
     SerializationCluster* cluster = clusters_by_cid_[cid];
     if (cluster != NULL) {
+      fill_positions[cluster_index++] = bytes_written();
       cluster->WriteAndMeasureFill(this);
 #if defined(DEBUG)
       Write<int32_t>(kSectionMarker);
 #endif
     }
   }
+  ASSERT(cluster_index == num_clusters);
+  fill_positions[cluster_index] = bytes_written();
+  if (!Utils::IsUint(32, bytes_written())) {
+    FATAL("Fill section overflow");
+  }
+  memmove(stream_.buffer() + fill_table_position, fill_positions.data(),
+          fill_positions.length() * sizeof(uint32_t));
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
   if (FLAG_print_snapshot_sizes_verbose) {
@@ -4718,11 +4769,15 @@ Deserializer::Deserializer(Thread* thread,
       heap_(thread->isolate()->heap()),
       zone_(thread->zone()),
       kind_(kind),
+      buffer_(buffer),
+      size_(size),
       stream_(buffer, size),
       image_reader_(NULL),
       refs_(NULL),
       next_ref_index_(1),
-      clusters_(NULL) {
+      clusters_(NULL),
+      fill_positions_(NULL),
+      next_fill_cluster_(0) {
   if (Snapshot::IncludesCode(kind)) {
     ASSERT(instructions_buffer != NULL);
     ASSERT(data_buffer != NULL);
@@ -4733,6 +4788,26 @@ Deserializer::Deserializer(Thread* thread,
   stream_.SetPosition(offset);
 }
 
+Deserializer::Deserializer(const Deserializer& parent, intptr_t position)
+    : ThreadStackResource(static_cast<Thread*>(NULL)),
+      heap_(parent.heap_),
+      zone_(NULL),
+      kind_(parent.kind_),
+      buffer_(parent.buffer_),
+      size_(parent.size_),
+      stream_(parent.buffer_, parent.size_),
+      image_reader_(parent.image_reader_),
+      num_base_objects_(parent.num_base_objects_),
+      num_objects_(parent.num_objects_),
+      num_clusters_(0),
+      refs_(parent.refs_),
+      next_ref_index_(parent.next_ref_index_),
+      clusters_(NULL),
+      fill_positions_(NULL),
+      next_fill_cluster_(0) {
+  stream_.SetPosition(position);
+}
+
 Deserializer::~Deserializer() {
   delete[] clusters_;
 }
@@ -5015,12 +5090,102 @@ void Deserializer::Deserialize() {
   // We should have completely filled the ref array.
   ASSERT((next_ref_index_ - 1) == num_objects_);
 
+  fill_positions_ = zone_->Alloc<uint32_t>(num_clusters_ + 1);
+  ReadBytes(reinterpret_cast<uint8_t*>(fill_positions_),
+            (num_clusters_ + 1) * sizeof(uint32_t));
+  FillClusters();
+}
+
+class Deserializer::FillTask : public ThreadPool::Task {
+ public:
+  FillTask(Deserializer* deserializer, Monitor* monitor, intptr_t* pending)
+      : deserializer_(deserializer), monitor_(monitor), pending_(pending) {}
+
+  virtual void Run() {
+    deserializer_->FillConcurrentClusters();
+    MonitorLocker ml(monitor_);
+    ASSERT(*pending_ > 0);
+    if (--(*pending_) == 0) {
+      ml.Notify();
+    }
+  }
+
+ private:
+  Deserializer* deserializer_;
+  Monitor* monitor_;
+  intptr_t* pending_;
+
+  DISALLOW_COPY_AND_ASSIGN(FillTask);
+};
+
+void Deserializer::FillClusters() {
+  const intptr_t fill_size =
+      fill_positions_[num_clusters_] - fill_positions_[0];
+  if ((FLAG_deserializer_tasks <= 0) ||
+      (fill_size < FLAG_deserializer_min_concurrent_fill_kb * KB)) {
+    ASSERT(stream_.Position() == fill_positions_[0]);
+    for (intptr_t i = 0; i < num_clusters_; i++) {
+      clusters_[i]->ReadFill(this);
+#if defined(DEBUG)
+      int32_t section_marker = Read<int32_t>();
+      ASSERT(section_marker == kSectionMarker);
+#endif
+    }
+    return;
+  }
+
+  // Clusters whose fill has effects beyond their own objects stay on the
+  // deserializing thread. The rest are claimed one at a time by this thread
+  // and the helper tasks.
   for (intptr_t i = 0; i < num_clusters_; i++) {
-    clusters_[i]->ReadFill(this);
+    if (!clusters_[i]->CanFillConcurrently()) {
+      stream_.SetPosition(fill_positions_[i]);
+      clusters_[i]->ReadFill(this);
 #if defined(DEBUG)
-    int32_t section_marker = Read<int32_t>();
-    ASSERT(section_marker == kSectionMarker);
+      int32_t section_marker = Read<int32_t>();
+      ASSERT(section_marker == kSectionMarker);
+#endif
+    }
+  }
+  Monitor monitor;
+  intptr_t pending = FLAG_deserializer_tasks;
+  for (intptr_t i = 0; i < FLAG_deserializer_tasks; i++) {
+    FillTask* task = new FillTask(this, &monitor, &pending);
+    if (!Dart::thread_pool()->Run(task)) {
+      // The pool is shutting down and did not take the task. Whatever it
+      // would have claimed is filled by this thread below.
+      delete task;
+      MonitorLocker ml(&monitor);
+      pending--;
+    }
+  }
+  FillConcurrentClusters();
+  {
+    MonitorLocker ml(&monitor);
+    while (pending > 0) {
+      ml.Wait();
+    }
+  }
+  stream_.SetPosition(fill_positions_[num_clusters_]);
+}
+
+void Deserializer::FillCluster(intptr_t cluster_index) {
+  Deserializer filler(*this, fill_positions_[cluster_index]);
+  clusters_[cluster_index]->ReadFill(&filler);
+#if defined(DEBUG)
+  int32_t section_marker = filler.Read<int32_t>();
+  ASSERT(section_marker == kSectionMarker);
+  ASSERT(filler.stream_.Position() == fill_positions_[cluster_index + 1]);
 #endif
+}
+
+void Deserializer::FillConcurrentClusters() {
+  for (intptr_t i = AtomicOperations::FetchAndIncrement(&next_fill_cluster_);
+       i < num_clusters_;
+       i = AtomicOperations::FetchAndIncrement(&next_fill_cluster_)) {
+    if (clusters_[i]->CanFillConcurrently()) {
+      FillCluster(i);
+    }
   }
 }
 
@@ -49,6 +49,11 @@ class ImageReader;
 // Finally, each cluster is given an opportunity to perform some fix-ups that
 // require the graph has been fully loaded, such as rehashing, though most
 // clusters do not require fixups.
+//
+// Since filling a cluster only reads refs that have already been allocated,
+// clusters can be filled independently of each other. The allocation section
+// is followed by a table of the positions of each cluster's fill data, which
+// lets the deserializer fill clusters on several threads.
 
 class SerializationCluster : public ZoneAllocated {
  public:
@@ -92,6 +97,10 @@ class DeserializationCluster : public ZoneAllocated {
   // Initialize the cluster's objects. Do not touch the memory of other objects.
   virtual void ReadFill(Deserializer* deserializer) = 0;
 
+  // Whether ReadFill only initializes the cluster's objects, so that it may
+  // run on a helper thread concurrently with the fill of other clusters.
+  virtual bool CanFillConcurrently() const { return true; }
+
   // Complete any action that requires the full graph to be deserialized, such
   // as rehashing.
   virtual void PostLoad(const Array& refs, Snapshot::Kind kind, Zone* zone) {}
@@ -579,9 +588,21 @@ class Deserializer : public ThreadStackResource {
   intptr_t code_order_length() const { return code_order_length_; }
 
  private:
+  class FillTask;
+
+  // Creates a deserializer which reads a cluster's fill data starting at
+  // [position] on a helper thread. It shares [parent]'s refs and images.
+  Deserializer(const Deserializer& parent, intptr_t position);
+
+  void FillClusters();
+  void FillCluster(intptr_t cluster_index);
+  void FillConcurrentClusters();
+
   Heap* heap_;
   Zone* zone_;
   Snapshot::Kind kind_;
+  const uint8_t* buffer_;
+  intptr_t size_;
   ReadStream stream_;
   ImageReader* image_reader_;
   intptr_t num_base_objects_;
@@ -591,6 +612,8 @@ class Deserializer : public ThreadStackResource {
   RawArray* refs_;
   intptr_t next_ref_index_;
   DeserializationCluster** clusters_;
+  uint32_t* fill_positions_;
+  intptr_t next_fill_cluster_;
 };
 
 #define ReadFromTo(obj, ...) d->ReadFromTo(obj, ##__VA_ARGS__);
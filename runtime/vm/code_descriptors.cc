@@ -649,6 +649,60 @@ void CodeSourceMapReader::DumpSourcePositions(uword start) {
   THR_Print("}\n");
 }
 
+void CodeSourceMapReader::GetInnermostPositions(
+    GrowableArray<int32_t>* pc_offsets,
+    GrowableArray<const Function*>* functions,
+    GrowableArray<TokenPosition>* token_positions) {
+  GrowableArray<const Function*> function_stack;
+  GrowableArray<TokenPosition> position_stack;
+  NoSafepointScope no_safepoint;
+  ReadStream stream(map_.Data(), map_.Length());
+
+  int32_t current_pc_offset = 0;
+  function_stack.Add(&root_);
+  position_stack.Add(CodeSourceMapBuilder::kInitialPosition);
+
+  while (stream.PendingBytes() > 0) {
+    uint8_t opcode = stream.Read<uint8_t>();
+    switch (opcode) {
+      case CodeSourceMapBuilder::kChangePosition: {
+        int32_t position = stream.Read<int32_t>();
+        position_stack[position_stack.length() - 1] = TokenPosition(position);
+        break;
+      }
+      case CodeSourceMapBuilder::kAdvancePC: {
+        int32_t delta = stream.Read<int32_t>();
+        pc_offsets->Add(current_pc_offset);
+        functions->Add(function_stack.Last());
+        token_positions->Add(position_stack.Last());
+        current_pc_offset += delta;
+        break;
+      }
+      case CodeSourceMapBuilder::kPushFunction: {
+        int32_t func = stream.Read<int32_t>();
+        function_stack.Add(
+            &Function::Handle(Function::RawCast(functions_.At(func))));
+        position_stack.Add(CodeSourceMapBuilder::kInitialPosition);
+        break;
+      }
+      case CodeSourceMapBuilder::kPopFunction: {
+        // We never pop the root function.
+        ASSERT(function_stack.length() > 1);
+        ASSERT(position_stack.length() > 1);
+        function_stack.RemoveLast();
+        position_stack.RemoveLast();
+        break;
+      }
+      case CodeSourceMapBuilder::kNullCheck: {
+        stream.Read<int32_t>();
+        break;
+      }
+      default:
+        UNREACHABLE();
+    }
+  }
+}
+
 intptr_t CodeSourceMapReader::GetNullCheckNameIndexAt(int32_t pc_offset) {
   NoSafepointScope no_safepoint;
   ReadStream stream(map_.Data(), map_.Length());
@@ -295,6 +295,12 @@ class CodeSourceMapReader : public ValueObject {
   void DumpInlineIntervals(uword start);
   void DumpSourcePositions(uword start);
 
+  // Appends one entry per range of PCs, starting at 'pc_offsets', with the
+  // innermost (possibly inlined) function and its token position.
+  void GetInnermostPositions(GrowableArray<int32_t>* pc_offsets,
+                             GrowableArray<const Function*>* functions,
+                             GrowableArray<TokenPosition>* token_positions);
+
   intptr_t GetNullCheckNameIndexAt(int32_t pc_offset);
 
  private:
@@ -6,8 +6,10 @@
 #include "vm/globals.h"
 
 #include "vm/code_descriptors.h"
+#include "vm/code_observers.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/compiler/jit/compiler.h"
+#include "vm/dart_api_impl.h"
 #include "vm/dart_entry.h"
 #include "vm/native_entry.h"
 #include "vm/parser.h"
@@ -165,4 +167,155 @@ ISOLATE_UNIT_TEST_CASE(DescriptorList_TokenPositions) {
   }
 }
 
+static const char* kSourcePositionsScript =
+    "int foo(int a, int b) {\n"
+    "  var c = a + b;\n"
+    "  return c * 2;\n"
+    "}\n";
+
+// Positions of the '+' and '*' calls in [kSourcePositionsScript].
+static const intptr_t kPlusLine = 2;
+static const intptr_t kPlusColumn = 13;
+static const intptr_t kTimesLine = 3;
+static const intptr_t kTimesColumn = 12;
+
+static RawFunction* CompileSourcePositionsFoo(Thread* thread,
+                                              Dart_Handle lib_handle) {
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(lib_handle)));
+  const Function& function = Function::Handle(
+      lib.LookupLocalFunction(String::Handle(Symbols::New(thread, "foo"))));
+  EXPECT(!function.IsNull());
+  EXPECT(CompilerTest::TestCompileFunction(function));
+  return function.raw();
+}
+
+TEST_CASE(CodeSourceMap_GetInnermostPositions) {
+  Dart_Handle lib = TestCase::LoadTestScript(kSourcePositionsScript, NULL);
+  EXPECT_VALID(lib);
+  TransitionNativeToVM transition(thread);
+  const Function& function =
+      Function::Handle(CompileSourcePositionsFoo(thread, lib));
+  const Code& code = Code::Handle(function.unoptimized_code());
+  EXPECT(!code.IsNull());
+  const CodeSourceMap& map = CodeSourceMap::Handle(code.code_source_map());
+  EXPECT(!map.IsNull());
+  const Array& id_map = Array::Handle(code.inlined_id_to_function());
+  CodeSourceMapReader reader(map, id_map, function);
+
+  GrowableArray<int32_t> pc_offsets;
+  GrowableArray<const Function*> functions;
+  GrowableArray<TokenPosition> token_positions;
+  reader.GetInnermostPositions(&pc_offsets, &functions, &token_positions);
+  EXPECT(pc_offsets.length() > 0);
+  EXPECT_EQ(pc_offsets.length(), functions.length());
+  EXPECT_EQ(pc_offsets.length(), token_positions.length());
+
+  const Script& script = Script::Handle(function.script());
+  bool saw_plus = false;
+  bool saw_times = false;
+  for (intptr_t i = 0; i < pc_offsets.length(); i++) {
+    if (i > 0) {
+      EXPECT(pc_offsets[i - 1] <= pc_offsets[i]);
+    }
+    EXPECT(pc_offsets[i] < code.Size());
+    // Nothing is inlined into unoptimized code.
+    EXPECT(functions[i]->raw() == function.raw());
+    if (!token_positions[i].IsReal()) continue;
+    intptr_t line = -1;
+    intptr_t column = -1;
+    script.GetTokenLocation(token_positions[i], &line, &column);
+    EXPECT(line >= 1 && line <= 4);
+    saw_plus |= (line == kPlusLine) && (column == kPlusColumn);
+    saw_times |= (line == kTimesLine) && (column == kTimesColumn);
+  }
+  EXPECT(saw_plus);
+  EXPECT(saw_times);
+}
+
+#if !defined(PRODUCT)
+
+// Records what CodeSourcePositions reports for the code of 'foo'. Code
+// observers cannot be unregistered, so it stays registered once created and
+// only listens while [active_] is set.
+class SourcePositionsObserver : public CodeObserver {
+ public:
+  SourcePositionsObserver() {}
+
+  static SourcePositionsObserver* Instance() {
+    if (instance_ == nullptr) {
+      instance_ = new SourcePositionsObserver();
+      CodeObservers::Register(instance_);
+    }
+    return instance_;
+  }
+
+  void Start() {
+    notified_ = false;
+    saw_plus_ = false;
+    saw_times_ = false;
+    sorted_ = true;
+    has_file_ = true;
+    active_ = true;
+  }
+  void Stop() { active_ = false; }
+
+  bool IsActive() const { return active_; }
+
+  void Notify(const char* name,
+              uword base,
+              uword prologue_offset,
+              uword size,
+              bool optimized,
+              const CodeComments* comments,
+              const CodeSourcePositions* positions) {
+    if (strstr(name, "foo") == nullptr) return;
+    notified_ = positions->Length() > 0;
+    for (intptr_t i = 0; i < positions->Length(); i++) {
+      if (i > 0 && positions->PCOffsetAt(i - 1) > positions->PCOffsetAt(i)) {
+        sorted_ = false;
+      }
+      const char* file = positions->FileAt(i);
+      if (file == nullptr || strstr(file, TestCase::url()) == nullptr) {
+        has_file_ = false;
+      }
+      const intptr_t line = positions->LineAt(i);
+      const intptr_t column = positions->ColumnAt(i);
+      saw_plus_ |= (line == kPlusLine) && (column == kPlusColumn);
+      saw_times_ |= (line == kTimesLine) && (column == kTimesColumn);
+    }
+  }
+
+  bool notified_ = false;
+  bool saw_plus_ = false;
+  bool saw_times_ = false;
+  bool sorted_ = true;
+  bool has_file_ = true;
+
+ private:
+  static SourcePositionsObserver* instance_;
+  bool active_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(SourcePositionsObserver);
+};
+
+SourcePositionsObserver* SourcePositionsObserver::instance_ = nullptr;
+
+TEST_CASE(CodeSourceMap_NotifyCodeObservers) {
+  Dart_Handle lib = TestCase::LoadTestScript(kSourcePositionsScript, NULL);
+  EXPECT_VALID(lib);
+  TransitionNativeToVM transition(thread);
+  SourcePositionsObserver* observer = SourcePositionsObserver::Instance();
+  observer->Start();
+  CompileSourcePositionsFoo(thread, lib);
+  observer->Stop();
+  EXPECT(observer->notified_);
+  EXPECT(observer->sorted_);
+  EXPECT(observer->has_file_);
+  EXPECT(observer->saw_plus_);
+  EXPECT(observer->saw_times_);
+}
+
+#endif  // !defined(PRODUCT)
+
 }  // namespace dart
@@ -26,6 +26,22 @@ class CodeComments : public ValueObject {
   virtual const char* CommentAt(intptr_t index) const = 0;
 };
 
+// An abstract representation of the source positions of the given code
+// object: one entry per range of PCs, naming the innermost (possibly inlined)
+// function's script and line. We assume that entries are sorted by PCOffset.
+class CodeSourcePositions : public ValueObject {
+ public:
+  CodeSourcePositions() = default;
+  virtual ~CodeSourcePositions() = default;
+
+  virtual intptr_t Length() const = 0;
+  virtual intptr_t PCOffsetAt(intptr_t index) const = 0;
+  // Returns NULL if the position is not in a script.
+  virtual const char* FileAt(intptr_t index) const = 0;
+  virtual intptr_t LineAt(intptr_t index) const = 0;
+  virtual intptr_t ColumnAt(intptr_t index) const = 0;
+};
+
 // Object observing code creation events. Used by external profilers and
 // debuggers to map address ranges to function names.
 class CodeObserver {
@@ -45,7 +61,8 @@ class CodeObserver {
                       uword prologue_offset,
                       uword size,
                       bool optimized,
-                      const CodeComments* comments) = 0;
+                      const CodeComments* comments,
+                      const CodeSourcePositions* positions) = 0;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(CodeObserver);
@@ -63,7 +80,8 @@ class CodeObservers : public AllStatic {
                         uword prologue_offset,
                         uword size,
                         bool optimized,
-                        const CodeComments* comments);
+                        const CodeComments* comments,
+                        const CodeSourcePositions* positions);
 
   // Returns true if there is at least one active code observer.
   static bool AreActive();
@@ -5,6 +5,7 @@
 #include "vm/compiler/aot/aot_call_specializer.h"
 
 #include "vm/bit_vector.h"
+#include "vm/compiler/aot/dispatch_table_generator.h"
 #include "vm/compiler/aot/precompiler.h"
 #include "vm/compiler/backend/branch_optimizer.h"
 #include "vm/compiler/backend/flow_graph_compiler.h"
@@ -1037,6 +1038,9 @@ void AotCallSpecializer::VisitInstanceCall(InstanceCallInstr* instr) {
                                                  /* complete = */ true);
         instr->ReplaceWith(call, current_iterator());
         return;
+      } else if (TryUseDispatchTable(instr, class_ids)) {
+        // Too many targets for exhaustive class checks.
+        return;
       }
     }
 
@@ -1069,6 +1073,37 @@ void AotCallSpecializer::VisitStaticCall(StaticCallInstr* instr) {
   CallSpecializer::VisitStaticCall(instr);
 }
 
+bool AotCallSpecializer::TryUseDispatchTable(
+    InstanceCallInstr* call,
+    const GrowableArray<intptr_t>& class_ids) {
+#if !defined(TARGET_ARCH_DBC) && !defined(TARGET_ARCH_IA32)
+  if ((precompiler_ == NULL) || class_ids.is_empty()) {
+    return false;
+  }
+  DispatchTableGenerator* table = precompiler_->dispatch_table_generator();
+  if (table == NULL) {
+    return false;
+  }
+  const intptr_t offset = table->SelectorOffset(call->function_name());
+  if (offset == DispatchTableGenerator::kNoOffset) {
+    return false;
+  }
+  Class& cls = Class::Handle(Z);
+  Function& target = Function::Handle(Z);
+  for (intptr_t i = 0; i < class_ids.length(); i++) {
+    cls = isolate()->class_table()->At(class_ids[i]);
+    target = call->ResolveForReceiverClass(cls);
+    if (target.IsNull() || !table->HasTarget(offset, class_ids[i], target)) {
+      return false;
+    }
+  }
+  call->set_dispatch_table(table->table(), offset);
+  return true;
+#else
+  return false;
+#endif
+}
+
 bool AotCallSpecializer::TryExpandCallThroughGetter(const Class& receiver_class,
                                                     InstanceCallInstr* call) {
   // If it's an accessor call it can't be a call through getter.
@@ -1187,6 +1222,21 @@ void AotCallSpecializer::VisitPolymorphicInstanceCall(
   }
 }
 
+// Unlike JIT, AOT keeps context allocations that escape as stub calls to
+// save code size and only inlines the ones allocation sinking can remove.
+void AotCallSpecializer::VisitAllocateContext(AllocateContextInstr* instr) {
+  if (IsNonEscapingAllocation(instr)) {
+    LowerContextAllocation(instr, instr->context_variables(), nullptr);
+  }
+}
+
+void AotCallSpecializer::VisitCloneContext(CloneContextInstr* instr) {
+  if (IsNonEscapingAllocation(instr)) {
+    LowerContextAllocation(instr, instr->context_variables(),
+                           instr->context_value());
+  }
+}
+
 bool AotCallSpecializer::TryReplaceInstanceOfWithRangeCheck(
     InstanceCallInstr* call,
     const AbstractType& type) {
@@ -24,6 +24,8 @@ class AotCallSpecializer : public CallSpecializer {
   virtual void VisitStaticCall(StaticCallInstr* instr);
   virtual void VisitPolymorphicInstanceCall(
       PolymorphicInstanceCallInstr* instr);
+  virtual void VisitAllocateContext(AllocateContextInstr* instr);
+  virtual void VisitCloneContext(CloneContextInstr* instr);
 
   virtual bool TryReplaceInstanceOfWithRangeCheck(InstanceCallInstr* call,
                                                   const AbstractType& type);
@@ -66,6 +68,12 @@ class AotCallSpecializer : public CallSpecializer {
   bool TryExpandCallThroughGetter(const Class& receiver_class,
                                   InstanceCallInstr* call);
 
+  // Marks [call] to dispatch through the global dispatch table if the table
+  // row of its selector resolves every one of [class_ids] the same way the
+  // call does.
+  bool TryUseDispatchTable(InstanceCallInstr* call,
+                           const GrowableArray<intptr_t>& class_ids);
+
   Definition* TryOptimizeMod(TemplateDartCall<0>* instr,
                              Token::Kind op_kind,
                              Value* left_value,
@@ -0,0 +1,232 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/aot/dispatch_table_generator.h"
+
+#include "vm/class_table.h"
+#include "vm/flags.h"
+#include "vm/log.h"
+#include "vm/stub_code.h"
+
+namespace dart {
+
+RowDisplacementPacker::RowDisplacementPacker(Zone* zone)
+    : used_(zone, 1024), first_free_(0) {}
+
+intptr_t RowDisplacementPacker::Place(const GrowableArray<intptr_t>& cids) {
+  ASSERT(!cids.is_empty());
+  intptr_t offset = Utils::Maximum<intptr_t>(first_free_ - cids[0], 0);
+  for (;; offset++) {
+    bool fits = true;
+    for (intptr_t j = 0; j < cids.length(); j++) {
+      const intptr_t slot = offset + cids[j];
+      if ((slot < used_.length()) && used_[slot]) {
+        fits = false;
+        break;
+      }
+    }
+    if (fits) break;
+  }
+
+  used_.EnsureLength(offset + cids.Last() + 1, false);
+  for (intptr_t j = 0; j < cids.length(); j++) {
+    used_[offset + cids[j]] = true;
+  }
+  while ((first_free_ < used_.length()) && used_[first_free_]) {
+    first_free_++;
+  }
+  return offset;
+}
+
+#if defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_DBC) &&                  \
+    !defined(TARGET_ARCH_IA32)
+
+DECLARE_FLAG(int, max_exhaustive_polymorphic_checks);
+DECLARE_FLAG(bool, trace_precompiler);
+
+DispatchTableGenerator::DispatchTableGenerator(Zone* zone)
+    : zone_(zone),
+      rows_(zone),
+      row_list_(zone, 0),
+      num_rows_(0),
+      table_(Array::ZoneHandle(zone)) {}
+
+bool DispatchTableGenerator::IsTableTarget(const Function& function) {
+  if (function.is_static() || function.is_abstract()) {
+    return false;
+  }
+  switch (function.kind()) {
+    case RawFunction::kRegularFunction:
+    case RawFunction::kGetterFunction:
+    case RawFunction::kSetterFunction:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void DispatchTableGenerator::Initialize(ClassTable* class_table) {
+  CollectSelectors(class_table);
+  CollectTargets(class_table);
+
+  // Only selectors with more implementations than exhaustive class checks
+  // can handle are called through the table.
+  GrowableArray<Row*> all_rows(zone_, row_list_.length());
+  all_rows.AddArray(row_list_);
+  row_list_.Clear();
+  for (intptr_t i = 0; i < all_rows.length(); i++) {
+    if (all_rows[i]->cids.length() > FLAG_max_exhaustive_polymorphic_checks) {
+      row_list_.Add(all_rows[i]);
+    }
+  }
+  num_rows_ = row_list_.length();
+  if (num_rows_ == 0) {
+    return;
+  }
+
+  ComputeOffsets();
+
+  intptr_t length = 0;
+  for (intptr_t i = 0; i < num_rows_; i++) {
+    Row* row = row_list_[i];
+    length = Utils::Maximum(length, row->offset + row->cids.Last() + 1);
+  }
+  table_ = Array::New(length, Heap::kOld);
+  for (intptr_t i = 0; i < num_rows_; i++) {
+    Row* row = row_list_[i];
+    for (intptr_t j = 0; j < row->cids.length(); j++) {
+      table_.SetAt(row->offset + row->cids[j], *row->targets[j]);
+    }
+  }
+
+  if (FLAG_trace_precompiler) {
+    intptr_t num_entries = 0;
+    for (intptr_t i = 0; i < num_rows_; i++) {
+      num_entries += row_list_[i]->cids.length();
+    }
+    THR_Print("Dispatch table: %" Pd " selectors, %" Pd " entries in %" Pd
+              " slots\n",
+              num_rows_, num_entries, length);
+  }
+}
+
+void DispatchTableGenerator::CollectSelectors(ClassTable* class_table) {
+  Class& cls = Class::Handle(zone_);
+  Array& functions = Array::Handle(zone_);
+  Function& function = Function::Handle(zone_);
+  String& name = String::Handle(zone_);
+
+  for (intptr_t cid = kIllegalCid + 1; cid < class_table->NumCids(); cid++) {
+    if (!class_table->HasValidClassAt(cid)) continue;
+    cls = class_table->At(cid);
+    if (!cls.is_finalized() || cls.IsTopLevel()) continue;
+    functions = cls.functions();
+    for (intptr_t i = 0; i < functions.Length(); i++) {
+      function ^= functions.At(i);
+      if (!IsTableTarget(function)) continue;
+      name = function.name();
+      if (rows_.LookupValue(&name) != NULL) continue;
+      const String* selector = &String::ZoneHandle(zone_, name.raw());
+      Row* row = new (zone_) Row(zone_, selector, row_list_.length());
+      rows_.Insert(RowTrait::Pair(row->selector, row));
+      row_list_.Add(row);
+    }
+  }
+}
+
+void DispatchTableGenerator::CollectTargets(ClassTable* class_table) {
+  Class& cls = Class::Handle(zone_);
+  Class& klass = Class::Handle(zone_);
+  Array& functions = Array::Handle(zone_);
+  Function& function = Function::Handle(zone_);
+  String& name = String::Handle(zone_);
+
+  for (intptr_t cid = kIllegalCid + 1; cid < class_table->NumCids(); cid++) {
+    if (!class_table->HasValidClassAt(cid)) continue;
+    cls = class_table->At(cid);
+    if (!cls.is_finalized() || cls.is_abstract() || cls.IsTopLevel()) {
+      continue;
+    }
+    // Walk up the superclass chain like dynamic lookup does: the first
+    // instance member with a given name is the one the receiver responds to.
+    for (klass = cls.raw(); !klass.IsNull(); klass = klass.SuperClass()) {
+      functions = klass.functions();
+      for (intptr_t i = 0; i < functions.Length(); i++) {
+        function ^= functions.At(i);
+        if (function.is_static()) continue;
+        name = function.name();
+        Row* row = rows_.LookupValue(&name);
+        if ((row == NULL) || (row->last_cid == cid)) continue;
+        row->last_cid = cid;
+        if (IsTableTarget(function)) {
+          row->cids.Add(cid);
+          row->targets.Add(&Function::ZoneHandle(zone_, function.raw()));
+        }
+      }
+    }
+  }
+}
+
+int DispatchTableGenerator::CompareRows(Row* const* a, Row* const* b) {
+  // Place the longest rows first, they are the hardest to fit.
+  const intptr_t a_length = (*a)->cids.length();
+  const intptr_t b_length = (*b)->cids.length();
+  if (a_length != b_length) {
+    return (a_length > b_length) ? -1 : 1;
+  }
+  return ((*a)->index < (*b)->index) ? -1 : 1;
+}
+
+void DispatchTableGenerator::ComputeOffsets() {
+  row_list_.Sort(CompareRows);
+
+  RowDisplacementPacker packer(zone_);
+  for (intptr_t i = 0; i < num_rows_; i++) {
+    row_list_[i]->offset = packer.Place(row_list_[i]->cids);
+  }
+}
+
+intptr_t DispatchTableGenerator::SelectorOffset(const String& selector) const {
+  if (table_.IsNull()) {
+    return kNoOffset;
+  }
+  // Rows that were too short to be laid out keep kNoOffset, calls to their
+  // selectors stay switchable calls.
+  Row* row = rows_.LookupValue(&selector);
+  return (row == NULL) ? kNoOffset : row->offset;
+}
+
+bool DispatchTableGenerator::HasTarget(intptr_t offset,
+                                       intptr_t cid,
+                                       const Function& target) const {
+  ASSERT(offset != kNoOffset);
+  const intptr_t slot = offset + cid;
+  return (slot < table_.Length()) && (table_.At(slot) == target.raw());
+}
+
+void DispatchTableGenerator::Finalize(const FunctionSet& retained_functions) {
+  if (table_.IsNull()) {
+    return;
+  }
+  const Code& fallback = StubCode::MegamorphicCall();
+  Object& entry = Object::Handle(zone_);
+  Function& function = Function::Handle(zone_);
+  Code& code = Code::Handle(zone_);
+  for (intptr_t i = 0; i < table_.Length(); i++) {
+    entry = table_.At(i);
+    code = fallback.raw();
+    if (entry.IsFunction()) {
+      function ^= entry.raw();
+      if (function.HasCode() && retained_functions.HasKey(&function)) {
+        code = function.CurrentCode();
+      }
+    }
+    table_.SetAt(i, code);
+  }
+}
+
+#endif  // defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_DBC) &&           \
+        // !defined(TARGET_ARCH_IA32)
+
+}  // namespace dart
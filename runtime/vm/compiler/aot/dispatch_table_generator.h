@@ -0,0 +1,141 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_AOT_DISPATCH_TABLE_GENERATOR_H_
+#define RUNTIME_VM_COMPILER_AOT_DISPATCH_TABLE_GENERATOR_H_
+
+#include "vm/compiler/aot/precompiler.h"
+#include "vm/growable_array.h"
+#include "vm/hash_map.h"
+#include "vm/object.h"
+
+namespace dart {
+
+// Packs rows of class ids into a single table by first-fit row displacement:
+// each row is placed at the lowest offset at which none of its class ids
+// collides with a slot taken by an earlier row.
+class RowDisplacementPacker : public ValueObject {
+ public:
+  explicit RowDisplacementPacker(Zone* zone);
+
+  // Returns the offset of a row with the given ascending, non-empty class ids
+  // and reserves its slots.
+  intptr_t Place(const GrowableArray<intptr_t>& cids);
+
+  // The number of slots spanned by the rows placed so far.
+  intptr_t length() const { return used_.length(); }
+
+ private:
+  GrowableArray<bool> used_;
+  intptr_t first_free_;
+
+  DISALLOW_COPY_AND_ASSIGN(RowDisplacementPacker);
+};
+
+#if defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_DBC) &&                  \
+    !defined(TARGET_ARCH_IA32)
+
+class ClassTable;
+
+// Builds the global dispatch table used by AOT instance calls that cannot be
+// devirtualized. Every selector implemented by many classes gets a row that
+// maps receiver class ids to targets; the rows are overlapped by row
+// displacement so the table stays compact. A call whose receiver is known to
+// be one of the row's classes dispatches with
+//
+//   table[selector_offset + receiver_cid]
+//
+// While the program is compiled the table holds the target Functions, which
+// lets call sites verify the row against their own resolution. Finalize then
+// replaces them with the Code to call. Slots that are not filled with a
+// compiled target dispatch through the megamorphic call stub, so a call site
+// must pass the MegamorphicCache of its selector along with the arguments
+// descriptor.
+class DispatchTableGenerator : public ZoneAllocated {
+ public:
+  static const intptr_t kNoOffset = -1;
+
+  explicit DispatchTableGenerator(Zone* zone);
+
+  // Computes the rows and their offsets for all finalized classes.
+  void Initialize(ClassTable* class_table);
+
+  // Returns the offset of the row of 'selector', or kNoOffset.
+  intptr_t SelectorOffset(const String& selector) const;
+
+  // Returns true if the row at 'offset' dispatches receivers of class 'cid'
+  // to 'target'.
+  bool HasTarget(intptr_t offset, intptr_t cid, const Function& target) const;
+
+  // Replaces the targets by their code. Targets that were not compiled or
+  // are not retained dispatch through the megamorphic call stub.
+  void Finalize(const FunctionSet& retained_functions);
+
+  intptr_t num_rows() const { return num_rows_; }
+
+  // The table; null if no selector has a row.
+  const Array& table() const { return table_; }
+
+ private:
+  struct Row : public ZoneAllocated {
+    Row(Zone* zone, const String* selector, intptr_t index)
+        : selector(selector),
+          index(index),
+          offset(kNoOffset),
+          last_cid(kIllegalCid),
+          cids(zone, 4),
+          targets(zone, 4) {}
+
+    const String* selector;
+    intptr_t index;  // Creation order, used to make the layout stable.
+    intptr_t offset;
+    intptr_t last_cid;
+    GrowableArray<intptr_t> cids;
+    GrowableArray<const Function*> targets;
+  };
+
+  class RowTrait {
+   public:
+    typedef const String* Key;
+    typedef Row* Value;
+
+    struct Pair {
+      Key key;
+      Value value;
+      Pair() : key(NULL), value(NULL) {}
+      Pair(const Key key, const Value& value) : key(key), value(value) {}
+      Pair(const Pair& other) : key(other.key), value(other.value) {}
+    };
+
+    static Key KeyOf(Pair kv) { return kv.key; }
+    static Value ValueOf(Pair kv) { return kv.value; }
+    static intptr_t Hashcode(Key key) { return key->Hash(); }
+    static bool IsKeyEqual(Pair kv, Key key) {
+      return kv.key->raw() == key->raw();
+    }
+  };
+
+  static int CompareRows(Row* const* a, Row* const* b);
+
+  static bool IsTableTarget(const Function& function);
+
+  void CollectSelectors(ClassTable* class_table);
+  void CollectTargets(ClassTable* class_table);
+  void ComputeOffsets();
+
+  Zone* zone_;
+  DirectChainedHashMap<RowTrait> rows_;
+  GrowableArray<Row*> row_list_;
+  intptr_t num_rows_;
+  Array& table_;
+
+  DISALLOW_COPY_AND_ASSIGN(DispatchTableGenerator);
+};
+
+#endif  // defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_DBC) &&           \
+        // !defined(TARGET_ARCH_IA32)
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_AOT_DISPATCH_TABLE_GENERATOR_H_
@@ -0,0 +1,80 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/aot/dispatch_table_generator.h"
+
+#include <initializer_list>
+
+#include "vm/growable_array.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+static intptr_t PlaceRow(RowDisplacementPacker* packer,
+                         Zone* zone,
+                         std::initializer_list<intptr_t> cids) {
+  GrowableArray<intptr_t> row(zone, cids.size());
+  for (intptr_t cid : cids) {
+    row.Add(cid);
+  }
+  return packer->Place(row);
+}
+
+ISOLATE_UNIT_TEST_CASE(RowDisplacementPacker_Offsets) {
+  Zone* zone = thread->zone();
+
+  // Rows that do not collide share offset 0.
+  {
+    RowDisplacementPacker packer(zone);
+    EXPECT_EQ(0, PlaceRow(&packer, zone, {1, 3}));
+    EXPECT_EQ(0, PlaceRow(&packer, zone, {2, 4}));
+    EXPECT_EQ(5, packer.length());
+  }
+
+  // A row is moved up until none of its slots are taken.
+  {
+    RowDisplacementPacker packer(zone);
+    EXPECT_EQ(0, PlaceRow(&packer, zone, {1, 2}));
+    EXPECT_EQ(2, PlaceRow(&packer, zone, {1, 2}));
+    EXPECT_EQ(1, PlaceRow(&packer, zone, {4, 5}));
+    EXPECT_EQ(7, packer.length());
+  }
+
+  // Short rows fill the gaps left by earlier ones.
+  {
+    RowDisplacementPacker packer(zone);
+    EXPECT_EQ(0, PlaceRow(&packer, zone, {0, 1, 2}));
+    EXPECT_EQ(0, PlaceRow(&packer, zone, {10, 11}));
+    EXPECT_EQ(0, PlaceRow(&packer, zone, {3}));
+    EXPECT_EQ(2, PlaceRow(&packer, zone, {10}));
+    EXPECT_EQ(1, PlaceRow(&packer, zone, {3}));
+    EXPECT_EQ(13, packer.length());
+  }
+}
+
+// Every class id of every row gets a slot of its own.
+ISOLATE_UNIT_TEST_CASE(RowDisplacementPacker_NoCollisions) {
+  Zone* zone = thread->zone();
+  RowDisplacementPacker packer(zone);
+  const intptr_t kNumRows = 50;
+  const intptr_t kMaxCid = 200;
+  GrowableArray<intptr_t> owner(zone, 0);
+  for (intptr_t i = 0; i < kNumRows; i++) {
+    GrowableArray<intptr_t> cids(zone, 0);
+    for (intptr_t cid = 1 + (i % 7); cid < kMaxCid; cid += 2 + (i % 11)) {
+      cids.Add(cid);
+    }
+    const intptr_t offset = packer.Place(cids);
+    EXPECT(offset >= 0);
+    owner.EnsureLength(packer.length(), -1);
+    for (intptr_t j = 0; j < cids.length(); j++) {
+      const intptr_t slot = offset + cids[j];
+      EXPECT_EQ(-1, owner[slot]);
+      owner[slot] = i;
+    }
+  }
+  EXPECT_EQ(packer.length(), owner.length());
+}
+
+}  // namespace dart
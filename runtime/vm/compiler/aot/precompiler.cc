@@ -7,6 +7,7 @@
 #include "vm/class_finalizer.h"
 #include "vm/code_patcher.h"
 #include "vm/compiler/aot/aot_call_specializer.h"
+#include "vm/compiler/aot/dispatch_table_generator.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/compiler/assembler/disassembler.h"
 #include "vm/compiler/backend/block_scheduler.h"
@@ -61,6 +62,11 @@ namespace dart {
 DEFINE_FLAG(bool, print_unique_targets, false, "Print unique dynamic targets");
 DEFINE_FLAG(bool, print_gop, false, "Print global object pool");
 DEFINE_FLAG(bool, trace_precompiler, false, "Trace precompiler.");
+DEFINE_FLAG(bool,
+            use_dispatch_table,
+            true,
+            "Call selectors with many implementations through a global "
+            "dispatch table indexed by receiver class id.");
 DEFINE_FLAG(
     int,
     max_speculative_inlining_attempts,
@@ -152,6 +158,7 @@ Precompiler::Precompiler(Thread* thread)
       dropped_typearg_count_(0),
       dropped_type_count_(0),
       dropped_library_count_(0),
+      dispatch_table_generator_(NULL),
       libraries_(GrowableObjectArray::Handle(I->object_store()->libraries())),
       pending_functions_(
           GrowableObjectArray::Handle(GrowableObjectArray::New())),
@@ -207,6 +214,10 @@ void Precompiler::DoCompileAll() {
       // as well as other type checks.
       HierarchyInfo hierarchy_info(T);
 
+      // Lay out the dispatch table before compiling anything, call sites
+      // need the offsets of their selectors.
+      InitializeDispatchTable();
+
       // Precompile constructors to compute information such as
       // optimized instruction count (used in inlining heuristics).
       ClassFinalizer::ClearAllCode(
@@ -305,6 +316,9 @@ void Precompiler::DoCompileAll() {
 
       TraceForRetainedFunctions();
       DropFunctions();
+      if (dispatch_table_generator_ != NULL) {
+        dispatch_table_generator_->Finalize(functions_to_retain_);
+      }
       DropFields();
       TraceTypesFromRetainedClasses();
       DropTypes();
@@ -343,6 +357,7 @@ void Precompiler::DoCompileAll() {
 
     ProgramVisitor::Dedup();
 
+    dispatch_table_generator_ = NULL;
     zone_ = NULL;
   }
 
@@ -371,6 +386,14 @@ void Precompiler::DoCompileAll() {
   }
 }
 
+void Precompiler::InitializeDispatchTable() {
+  if (!FLAG_use_dispatch_table) {
+    return;
+  }
+  dispatch_table_generator_ = new (Z) DispatchTableGenerator(Z);
+  dispatch_table_generator_->Initialize(I->class_table());
+}
+
 void Precompiler::PrecompileConstructors() {
   class ConstructorVisitor : public FunctionVisitor {
    public:
@@ -2220,8 +2243,8 @@ void PrecompileParsedFunctionHelper::FinalizeCompilation(
                                    ? Code::PoolAttachment::kNotAttachPool
                                    : Code::PoolAttachment::kAttachPool;
   const Code& code = Code::Handle(
-      Code::FinalizeCodeAndNotify(function, graph_compiler, assembler,
-                                  pool_attachment, optimized(), stats));
+      Code::FinalizeCode(graph_compiler, assembler, pool_attachment,
+                         optimized(), stats));
   code.set_is_optimized(optimized());
   code.set_owner(function);
   if (!function.IsOptimizable()) {
@@ -2240,6 +2263,10 @@ void PrecompileParsedFunctionHelper::FinalizeCompilation(
   graph_compiler->FinalizeStaticCallTargetsTable(code);
   graph_compiler->FinalizeCodeSourceMap(code);
 
+  // Observers read the owner and the source map, so notify them only once
+  // both are set.
+  Code::NotifyCodeObservers(function, code, optimized());
+
   if (optimized()) {
     // Installs code while at safepoint.
     ASSERT(thread()->IsMutatorThread());
@@ -27,6 +27,7 @@ class ParsedJSONObject;
 class ParsedJSONArray;
 class Precompiler;
 class FlowGraph;
+class DispatchTableGenerator;
 class PrecompilerEntryPointsPrinter;
 
 class SymbolKeyValueTrait {
@@ -233,6 +234,11 @@ class Precompiler : public ValueObject {
     return &global_object_pool_builder_;
   }
 
+  // Only available while the program is compiled.
+  DispatchTableGenerator* dispatch_table_generator() const {
+    return dispatch_table_generator_;
+  }
+
   static Precompiler* Instance() { return singleton_; }
 
  private:
@@ -268,6 +274,8 @@ class Precompiler : public ValueObject {
 
   void AttachOptimizedTypeTestingStub();
 
+  void InitializeDispatchTable();
+
   void TraceForRetainedFunctions();
   void DropFunctions();
   void DropFields();
@@ -312,6 +320,7 @@ class Precompiler : public ValueObject {
   intptr_t dropped_library_count_;
 
   compiler::ObjectPoolBuilder global_object_pool_builder_;
+  DispatchTableGenerator* dispatch_table_generator_;
   GrowableObjectArray& libraries_;
   const GrowableObjectArray& pending_functions_;
   SymbolSet sent_selectors_;
@@ -157,6 +157,34 @@ static void Union(GrowableArray<Chain*>* chains,
   }
 }
 
+// Returns true if 'block' is the successor of a branch whose other
+// successor was taken while this one never was.
+static bool IsNeverTakenTarget(BlockEntryInstr* block) {
+  TargetEntryInstr* target = block->AsTargetEntry();
+  if ((target == NULL) || (target->edge_weight() != 0.0) ||
+      (target->PredecessorCount() != 1)) {
+    return false;
+  }
+  BranchInstr* branch =
+      target->PredecessorAt(0)->last_instruction()->AsBranch();
+  if (branch == NULL) {
+    return false;
+  }
+  TargetEntryInstr* other = (branch->true_successor() == target)
+                                ? branch->false_successor()
+                                : branch->true_successor();
+  return other->edge_weight() > 0.0;
+}
+
+static bool IsColdChain(Chain* chain, const GrowableArray<bool>& is_cold) {
+  for (Link* link = chain->first; link != NULL; link = link->next) {
+    if (!is_cold[link->block->preorder_number()]) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void BlockScheduler::ReorderBlocks() const {
   if (FLAG_precompiled_mode) {
     ReorderBlocksAOT();
@@ -199,6 +227,10 @@ void BlockScheduler::ReorderBlocksJIT() const {
     }
   }
 
+  GrowableArray<bool> is_cold(block_count);
+  is_cold.FillWith(false, 0, block_count);
+  ComputeColdBlocks(&is_cold);
+
   // Handle each edge in turn.  The edges are sorted by increasing weight.
   edges.Sort(Edge::LowestWeightFirst);
   while (!edges.is_empty()) {
@@ -215,32 +247,45 @@ void BlockScheduler::ReorderBlocksJIT() const {
       continue;
     }
 
+    // Keep cold blocks out of chains with hot blocks, so they can be moved
+    // to the end.
+    if (is_cold[edge.source->preorder_number()] !=
+        is_cold[edge.target->preorder_number()]) {
+      continue;
+    }
+
     Union(&chains, source_chain, target_chain);
   }
 
   // Build a new block order.  Emit each chain when its first block occurs
   // in the original reverse postorder ordering (which gives a topological
-  // sort of the blocks).
+  // sort of the blocks).  Chains consisting only of cold blocks are emitted
+  // after all other chains, so the code executed in the common case stays
+  // contiguous.
   for (intptr_t i = block_count - 1; i >= 0; --i) {
-    if (chains[i]->first->block == flow_graph()->postorder()[i]) {
+    if ((chains[i]->first->block == flow_graph()->postorder()[i]) &&
+        !IsColdChain(chains[i], is_cold)) {
       for (Link* link = chains[i]->first; link != NULL; link = link->next) {
         flow_graph()->CodegenBlockOrder(true)->Add(link->block);
       }
     }
   }
-}
-
-// Moves blocks ending in a throw/rethrow, as well as any block post-dominated
-// by such a throwing block, to the end.
-void BlockScheduler::ReorderBlocksAOT() const {
-  if (!FLAG_reorder_basic_blocks) {
-    return;
+  for (intptr_t i = block_count - 1; i >= 0; --i) {
+    if ((chains[i]->first->block == flow_graph()->postorder()[i]) &&
+        IsColdChain(chains[i], is_cold)) {
+      for (Link* link = chains[i]->first; link != NULL; link = link->next) {
+        flow_graph()->CodegenBlockOrder(true)->Add(link->block);
+      }
+    }
   }
+}
 
+// Marks blocks ending in a throw/rethrow, as well as any block post-dominated
+// by such a throwing block.  The array is indexed by preorder number.
+void BlockScheduler::ComputeTerminatingBlocks(
+    GrowableArray<bool>* is_terminating) const {
   auto& reverse_postorder = flow_graph()->reverse_postorder();
   const intptr_t block_count = reverse_postorder.length();
-  GrowableArray<bool> is_terminating(block_count);
-  is_terminating.FillWith(false, 0, block_count);
 
   // Any block in the worklist is marked and any of its unconditional
   // predecessors need to be marked as well.
@@ -252,7 +297,7 @@ void BlockScheduler::ReorderBlocksAOT() const {
     auto last = block->last_instruction();
     if (last->IsThrow() || last->IsReThrow()) {
       const intptr_t preorder_nr = block->preorder_number();
-      is_terminating[preorder_nr] = true;
+      (*is_terminating)[preorder_nr] = true;
       worklist.Add(block);
     }
   }
@@ -265,28 +310,78 @@ void BlockScheduler::ReorderBlocksAOT() const {
       auto predecessor = block->PredecessorAt(i);
       if (predecessor->last_instruction()->IsGoto()) {
         const intptr_t preorder_nr = predecessor->preorder_number();
-        if (!is_terminating[preorder_nr]) {
-          is_terminating[preorder_nr] = true;
+        if (!(*is_terminating)[preorder_nr]) {
+          (*is_terminating)[preorder_nr] = true;
           worklist.Add(predecessor);
         }
       }
     }
   }
+}
+
+// Marks the blocks which are not expected to execute: throwing blocks, catch
+// entries, blocks all of whose predecessors are cold and, if edge counters
+// were collected, the untaken side of a branch whose other side was taken.
+// Blocks created by the optimizer carry no counts, so a zero weight on its
+// own is not evidence enough.
+void BlockScheduler::ComputeColdBlocks(GrowableArray<bool>* is_cold) const {
+  ComputeTerminatingBlocks(is_cold);
+
+  const bool has_counts = flow_graph()->graph_entry()->entry_count() > 0;
+  auto& reverse_postorder = flow_graph()->reverse_postorder();
+  for (intptr_t i = 0; i < reverse_postorder.length(); ++i) {
+    BlockEntryInstr* block = reverse_postorder[i];
+    const intptr_t preorder_nr = block->preorder_number();
+    if ((*is_cold)[preorder_nr]) {
+      continue;
+    }
+    if (block->IsCatchBlockEntry()) {
+      (*is_cold)[preorder_nr] = true;
+      continue;
+    }
+    if (has_counts && IsNeverTakenTarget(block)) {
+      (*is_cold)[preorder_nr] = true;
+      continue;
+    }
+    // Loop back edges are not visited yet and keep loop headers hot.
+    bool all_predecessors_cold = block->PredecessorCount() > 0;
+    for (intptr_t j = 0; j < block->PredecessorCount(); ++j) {
+      if (!(*is_cold)[block->PredecessorAt(j)->preorder_number()]) {
+        all_predecessors_cold = false;
+        break;
+      }
+    }
+    (*is_cold)[preorder_nr] = all_predecessors_cold;
+  }
+}
+
+// Moves cold blocks to the end: blocks ending in a throw/rethrow, any block
+// post-dominated by such a throwing block, and catch entries. AOT code has no
+// edge counts, so these are the only blocks known to be cold.
+void BlockScheduler::ReorderBlocksAOT() const {
+  if (!FLAG_reorder_basic_blocks) {
+    return;
+  }
+
+  auto& reverse_postorder = flow_graph()->reverse_postorder();
+  const intptr_t block_count = reverse_postorder.length();
+  GrowableArray<bool> is_cold(block_count);
+  is_cold.FillWith(false, 0, block_count);
+  ComputeColdBlocks(&is_cold);
 
-  // Emit code in reverse postorder but move any throwing blocks to the very
-  // end.
+  // Emit code in reverse postorder but move any cold blocks to the very end.
   auto& codegen_order = *flow_graph()->CodegenBlockOrder(true);
   for (intptr_t i = 0; i < block_count; ++i) {
     auto block = reverse_postorder[i];
     const intptr_t preorder_nr = block->preorder_number();
-    if (!is_terminating[preorder_nr]) {
+    if (!is_cold[preorder_nr]) {
       codegen_order.Add(block);
     }
   }
   for (intptr_t i = 0; i < block_count; ++i) {
     auto block = reverse_postorder[i];
     const intptr_t preorder_nr = block->preorder_number();
-    if (is_terminating[preorder_nr]) {
+    if (is_cold[preorder_nr]) {
       codegen_order.Add(block);
     }
   }
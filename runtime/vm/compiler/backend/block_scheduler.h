@@ -6,6 +6,7 @@
 #define RUNTIME_VM_COMPILER_BACKEND_BLOCK_SCHEDULER_H_
 
 #include "vm/allocation.h"
+#include "vm/growable_array.h"
 
 namespace dart {
 
@@ -24,6 +25,9 @@ class BlockScheduler : public ValueObject {
   void ReorderBlocksAOT() const;
   void ReorderBlocksJIT() const;
 
+  void ComputeTerminatingBlocks(GrowableArray<bool>* is_terminating) const;
+  void ComputeColdBlocks(GrowableArray<bool>* is_cold) const;
+
   FlowGraph* const flow_graph_;
 };
 
@@ -0,0 +1,140 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/block_scheduler.h"
+
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_state.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+static const char* kScript =
+    "int thrower(int x) {\n"
+    "  if (x > 100) {\n"
+    "    throw 'too big';\n"
+    "  }\n"
+    "  return x + 1;\n"
+    "}\n"
+    "int branchy(int x) {\n"
+    "  int r;\n"
+    "  if (x > 100) {\n"
+    "    r = x * 2;\n"
+    "  } else {\n"
+    "    r = x - 1;\n"
+    "  }\n"
+    "  return r + 1;\n"
+    "}\n"
+    "int catcher(int x) {\n"
+    "  try {\n"
+    "    return thrower(x);\n"
+    "  } catch (e) {\n"
+    "    return -1;\n"
+    "  }\n"
+    "}\n"
+    "main() {\n"
+    "  thrower(1);\n"
+    "  branchy(1);\n"
+    "  catcher(1);\n"
+    "}\n";
+
+// Builds the optimizing flow graph of the given function in kScript.
+static FlowGraph* BuildGraph(const Library& lib, const char* function_name) {
+  TestPipeline pipeline(Function::Handle(GetFunction(lib, function_name)));
+  return pipeline.RunPasses({});
+}
+
+static intptr_t PositionOf(const GrowableArray<BlockEntryInstr*>& order,
+                           BlockEntryInstr* block) {
+  for (intptr_t i = 0; i < order.length(); i++) {
+    if (order[i] == block) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// Returns true if all blocks from 'start' on are only reached from blocks at
+// or after 'start', so that they form the tail of the code.
+static bool IsClosedTail(const GrowableArray<BlockEntryInstr*>& order,
+                         intptr_t start) {
+  for (intptr_t i = start + 1; i < order.length(); i++) {
+    BlockEntryInstr* block = order[i];
+    for (intptr_t j = 0; j < block->PredecessorCount(); j++) {
+      if (PositionOf(order, block->PredecessorAt(j)) < start) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+TEST_CASE(BlockScheduler_ColdBlocksLast) {
+  TransitionNativeToVM transition(thread);
+  const Library& lib = Library::Handle(LoadTestScript(kScript));
+  Invoke(lib, "main");
+
+  // A throwing block is moved behind the returning code.
+  {
+    CompilerState state(thread);
+    FlowGraph* flow_graph = BuildGraph(lib, "thrower");
+    BlockScheduler(flow_graph).ReorderBlocks();
+    const GrowableArray<BlockEntryInstr*>& order =
+        *flow_graph->CodegenBlockOrder(true);
+    EXPECT_EQ(flow_graph->reverse_postorder().length(), order.length());
+    EXPECT(order.Last()->last_instruction()->IsThrow());
+  }
+
+  // A catch entry and its handler go after the code of the try block.
+  {
+    CompilerState state(thread);
+    FlowGraph* flow_graph = BuildGraph(lib, "catcher");
+    BlockScheduler(flow_graph).ReorderBlocks();
+    const GrowableArray<BlockEntryInstr*>& order =
+        *flow_graph->CodegenBlockOrder(true);
+    intptr_t catch_position = -1;
+    for (intptr_t i = 0; i < order.length(); i++) {
+      if (order[i]->IsCatchBlockEntry()) {
+        catch_position = i;
+      }
+    }
+    EXPECT(catch_position > 0);
+    EXPECT(
+        PositionOf(order, flow_graph->graph_entry()->normal_entry()) <
+        catch_position);
+    EXPECT(IsClosedTail(order, catch_position));
+  }
+
+  // With edge counts, the side of a branch that was never taken goes last.
+  {
+    CompilerState state(thread);
+    FlowGraph* flow_graph = BuildGraph(lib, "branchy");
+    BranchInstr* branch = nullptr;
+    for (BlockIterator it = flow_graph->reverse_postorder_iterator();
+         !it.Done() && (branch == nullptr); it.Advance()) {
+      branch = it.Current()->last_instruction()->AsBranch();
+    }
+    EXPECT(branch != nullptr);
+    if (branch == nullptr) {
+      return;
+    }
+    TargetEntryInstr* taken = branch->false_successor();
+    TargetEntryInstr* never_taken = branch->true_successor();
+    flow_graph->graph_entry()->set_entry_count(10);
+    taken->set_edge_weight(1.0);
+    never_taken->set_edge_weight(0.0);
+    if (taken->last_instruction()->IsGoto()) {
+      taken->last_instruction()->AsGoto()->set_edge_weight(1.0);
+    }
+    BlockScheduler(flow_graph).ReorderBlocks();
+    const GrowableArray<BlockEntryInstr*>& order =
+        *flow_graph->CodegenBlockOrder(true);
+    EXPECT(PositionOf(order, taken) < PositionOf(order, never_taken));
+    EXPECT(IsClosedTail(order, PositionOf(order, never_taken)));
+  }
+}
+
+}  // namespace dart
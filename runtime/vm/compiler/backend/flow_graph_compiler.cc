@@ -67,6 +67,7 @@ DECLARE_FLAG(int, stacktrace_every);
 DECLARE_FLAG(charp, stacktrace_filter);
 DECLARE_FLAG(int, gc_every);
 DECLARE_FLAG(bool, trace_compiler);
+DECLARE_FLAG(bool, unbox_numeric_fields);
 
 // Assign locations to incoming arguments, i.e., values pushed above spill slots
 // with PushArgument.  Recursively allocates from outermost to innermost
@@ -178,6 +179,12 @@ bool FlowGraphCompiler::IsUnboxedField(const Field& field) {
 }
 
 bool FlowGraphCompiler::IsPotentialUnboxedField(const Field& field) {
+  if (FLAG_precompiled_mode) {
+    // Without field guards the guarded class id of a field never changes, so
+    // a field is either unboxed or it is not. It is unboxed if type flow
+    // analysis proved that it always holds a non-null double or SIMD value.
+    return false;
+  }
   return field.is_unboxing_candidate() &&
          (FlowGraphCompiler::IsUnboxedField(field) ||
           (field.guarded_cid() == kIllegalCid));
@@ -1169,8 +1176,12 @@ bool FlowGraphCompiler::TryIntrinsify() {
 
         // Only intrinsify getter if the field cannot contain a mutable double.
         // Reading from a mutable double box requires allocating a fresh double.
-        if (field.is_instance() &&
-            (FLAG_precompiled_mode || !IsPotentialUnboxedField(field))) {
+        // In AOT only fields proven by type flow analysis are unboxed.
+        const bool may_be_unboxed =
+            FLAG_precompiled_mode
+                ? (FLAG_unbox_numeric_fields && IsUnboxedField(field))
+                : IsPotentialUnboxedField(field);
+        if (field.is_instance() && !may_be_unboxed) {
           SpecialStatsBegin(CombinedCodeStatistics::kTagIntrinsics);
           GenerateGetterIntrinsic(field.Offset());
           SpecialStatsEnd(CombinedCodeStatistics::kTagIntrinsics);
@@ -1547,11 +1558,34 @@ void ParallelMoveResolver::EmitNativeCode(ParallelMoveInstr* parallel_move) {
     if (!move.IsEliminated() && !move.src().IsConstant()) PerformMove(i);
   }
 
-  // Perform the moves with constant sources.
+  // Perform the moves with constant sources, those into registers first. A
+  // constant that is also stored into a stack slot is then stored from the
+  // register instead of being materialized again.
+  GrowableArray<Location> constants;
+  GrowableArray<Location> registers;
   for (int i = 0; i < moves_.length(); ++i) {
     const MoveOperands& move = *moves_[i];
-    if (!move.IsEliminated()) {
+    if (!move.IsEliminated() && move.dest().IsRegister()) {
       ASSERT(move.src().IsConstant());
+      constants.Add(move.src());
+      registers.Add(move.dest());
+      compiler_->BeginCodeSourceRange();
+      EmitMove(i);
+      compiler_->EndCodeSourceRange(TokenPosition::kParallelMove);
+    }
+  }
+  for (int i = 0; i < moves_.length(); ++i) {
+    MoveOperands* move = moves_[i];
+    if (!move->IsEliminated()) {
+      ASSERT(move->src().IsConstant());
+      if (move->dest().IsStackSlot()) {
+        for (intptr_t j = 0; j < constants.length(); j++) {
+          if (constants[j].Equals(move->src())) {
+            move->set_src(registers[j]);
+            break;
+          }
+        }
+      }
       compiler_->BeginCodeSourceRange();
       EmitMove(i);
       compiler_->EndCodeSourceRange(TokenPosition::kParallelMove);
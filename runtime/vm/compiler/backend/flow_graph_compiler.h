@@ -592,6 +592,17 @@ class FlowGraphCompiler : public ValueObject {
       LocationSummary* locs,
       Code::EntryKind entry_kind = Code::EntryKind::kNormal);
 
+  // AOT only: calls the entry at [selector_offset] plus the receiver's class
+  // id in the global dispatch [table]. Slots without a compiled target hold
+  // the megamorphic call stub, which uses the cache for [function_name].
+  void EmitDispatchTableCall(const String& function_name,
+                             const Array& arguments_descriptor,
+                             const Array& table,
+                             intptr_t selector_offset,
+                             intptr_t deopt_id,
+                             TokenPosition token_pos,
+                             LocationSummary* locs);
+
   void EmitTestAndCall(const CallTargets& targets,
                        const String& function_name,
                        ArgumentsInfo args_info,
@@ -1112,6 +1112,39 @@ void FlowGraphCompiler::EmitMegamorphicInstanceCall(
   __ Drop(args_desc.CountWithTypeArgs());
 }
 
+void FlowGraphCompiler::EmitDispatchTableCall(
+    const String& function_name,
+    const Array& arguments_descriptor,
+    const Array& table,
+    intptr_t selector_offset,
+    intptr_t deopt_id,
+    TokenPosition token_pos,
+    LocationSummary* locs) {
+  ASSERT(FLAG_precompiled_mode);
+  const ArgumentsDescriptor args_desc(arguments_descriptor);
+  ASSERT(!table.IsNull());
+  const MegamorphicCache& cache = MegamorphicCache::ZoneHandle(
+      zone(), MegamorphicCacheTable::Lookup(isolate(), function_name,
+                                            arguments_descriptor));
+
+  __ Comment("DispatchTableCall");
+  __ LoadFromOffset(kWord, R0, SP, (args_desc.Count() - 1) * kWordSize);
+  __ LoadClassIdMayBeSmi(R1, R0);
+  __ LoadObject(R2, table);
+  __ add(R2, R2, Operand(R1, LSL, kWordSizeLog2));
+  __ LoadFieldFromOffset(kWord, CODE_REG, R2,
+                         Array::element_offset(selector_offset));
+  // Slots without a compiled target hold the megamorphic call stub.
+  __ LoadObject(R9, cache);
+  __ LoadObject(R4, arguments_descriptor);
+  __ ldr(LR, FieldAddress(CODE_REG, Code::entry_point_offset()));
+  __ blx(LR);
+
+  EmitCallsiteMetadata(token_pos, DeoptId::kNone, RawPcDescriptors::kOther,
+                       locs);
+  __ Drop(args_desc.CountWithTypeArgs());
+}
+
 void FlowGraphCompiler::EmitSwitchableInstanceCall(const ICData& ic_data,
                                                    intptr_t deopt_id,
                                                    TokenPosition token_pos,
@@ -974,6 +974,18 @@ void FlowGraphCompiler::EmitSwitchableInstanceCall(const ICData& ic_data,
   UNREACHABLE();
 }
 
+void FlowGraphCompiler::EmitDispatchTableCall(
+    const String& function_name,
+    const Array& arguments_descriptor,
+    const Array& table,
+    intptr_t selector_offset,
+    intptr_t deopt_id,
+    TokenPosition token_pos,
+    LocationSummary* locs) {
+  // Only generated with precompilation.
+  UNREACHABLE();
+}
+
 void FlowGraphCompiler::EmitOptimizedStaticCall(
     const Function& function,
     const Array& arguments_descriptor,
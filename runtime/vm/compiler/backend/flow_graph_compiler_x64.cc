@@ -1133,6 +1133,36 @@ void FlowGraphCompiler::EmitSwitchableInstanceCall(const ICData& ic_data,
   __ Drop(ic_data.CountWithTypeArgs(), RCX);
 }
 
+void FlowGraphCompiler::EmitDispatchTableCall(
+    const String& function_name,
+    const Array& arguments_descriptor,
+    const Array& table,
+    intptr_t selector_offset,
+    intptr_t deopt_id,
+    TokenPosition token_pos,
+    LocationSummary* locs) {
+  ASSERT(FLAG_precompiled_mode);
+  const ArgumentsDescriptor args_desc(arguments_descriptor);
+  ASSERT(!table.IsNull());
+  const MegamorphicCache& cache = MegamorphicCache::ZoneHandle(
+      zone(), MegamorphicCacheTable::Lookup(isolate(), function_name,
+                                            arguments_descriptor));
+
+  __ Comment("DispatchTableCall");
+  __ movq(RDI, Address(RSP, (args_desc.Count() - 1) * kWordSize));
+  __ LoadClassIdMayBeSmi(RAX, RDI);
+  __ LoadObject(RCX, table);
+  __ movq(CODE_REG, FieldAddress(RCX, RAX, TIMES_8,
+                                 Array::element_offset(selector_offset)));
+  // Slots without a compiled target hold the megamorphic call stub.
+  __ LoadObject(RBX, cache);
+  __ LoadObject(R10, arguments_descriptor);
+  __ call(FieldAddress(CODE_REG, Code::entry_point_offset()));
+
+  EmitCallsiteMetadata(token_pos, deopt_id, RawPcDescriptors::kOther, locs);
+  __ Drop(args_desc.CountWithTypeArgs(), RCX);
+}
+
 void FlowGraphCompiler::EmitOptimizedStaticCall(
     const Function& function,
     const Array& arguments_descriptor,
@@ -4087,6 +4087,17 @@ static void TryFastPathSmiOp(FlowGraphCompiler* compiler,
 
 void InstanceCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   Zone* zone = compiler->zone();
+#if !defined(TARGET_ARCH_DBC)
+  if (dispatch_table_offset() != kNoDispatchTableOffset) {
+    ASSERT(FLAG_precompiled_mode && compiler->is_optimizing());
+    const Array& arguments_descriptor =
+        Array::ZoneHandle(zone, GetArgumentsDescriptor());
+    compiler->EmitDispatchTableCall(function_name(), arguments_descriptor,
+                                    *dispatch_table(), dispatch_table_offset(),
+                                    deopt_id(), token_pos(), locs());
+    return;
+  }
+#endif
   const ICData* call_ic_data = NULL;
   if (!FLAG_propagate_ic_data || !compiler->is_optimizing() ||
       (ic_data() == NULL)) {
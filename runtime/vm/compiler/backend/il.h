@@ -2011,7 +2011,8 @@ class PhiInstr : public Definition {
         representation_(kTagged),
         reaching_defs_(NULL),
         is_alive_(false),
-        is_receiver_(kUnknownReceiver) {
+        is_receiver_(kUnknownReceiver),
+        identity_(AliasIdentity::Unknown()) {
     for (intptr_t i = 0; i < num_inputs; ++i) {
       inputs_.Add(NULL);
     }
@@ -2075,6 +2076,9 @@ class PhiInstr : public Definition {
 
   void set_is_receiver(ReceiverType is_receiver) { is_receiver_ = is_receiver; }
 
+  virtual AliasIdentity Identity() const { return identity_; }
+  virtual void SetIdentity(AliasIdentity identity) { identity_ = identity; }
+
  private:
   // Direct access to inputs_ in order to resize it due to unreachable
   // predecessors.
@@ -2088,6 +2092,7 @@ class PhiInstr : public Definition {
   BitVector* reaching_defs_;
   bool is_alive_;
   int8_t is_receiver_;
+  AliasIdentity identity_;
 
   DISALLOW_COPY_AND_ASSIGN(PhiInstr);
 };
@@ -2671,6 +2676,8 @@ class BranchInstr : public Instruction {
     return comparison()->HasUnknownSideEffects();
   }
 
+  virtual bool CanTriggerGC() const { return comparison()->CanTriggerGC(); }
+
   ComparisonInstr* comparison() const { return comparison_; }
   void SetComparison(ComparisonInstr* comp);
 
@@ -3329,6 +3336,19 @@ class InstanceCallInstr : public TemplateDartCall<0> {
 
   void set_entry_kind(Code::EntryKind value) { entry_kind_ = value; }
 
+  // In AOT, calls whose receiver classes all resolve through the global
+  // dispatch table (see DispatchTableGenerator) remember the table and the
+  // offset of their selector's row and are emitted as table calls instead of
+  // switchable calls.
+  static const intptr_t kNoDispatchTableOffset = -1;
+  const Array* dispatch_table() const { return dispatch_table_; }
+  intptr_t dispatch_table_offset() const { return dispatch_table_offset_; }
+  void set_dispatch_table(const Array& table, intptr_t offset) {
+    ASSERT(table.IsZoneHandle());
+    dispatch_table_ = &table;
+    dispatch_table_offset_ = offset;
+  }
+
  protected:
   friend class CallSpecializer;
   void set_ic_data(ICData* value) { ic_data_ = value; }
@@ -3342,6 +3362,8 @@ class InstanceCallInstr : public TemplateDartCall<0> {
   CompileType* result_type_;  // Inferred result type.
   bool has_unique_selector_;
   Code::EntryKind entry_kind_ = Code::EntryKind::kNormal;
+  const Array* dispatch_table_ = nullptr;
+  intptr_t dispatch_table_offset_ = kNoDispatchTableOffset;
 
   const AbstractType* static_receiver_type_ = nullptr;
 
@@ -4696,6 +4718,10 @@ class StoreIndexedInstr : public TemplateInstruction<3, NoThrow> {
            (emit_store_barrier_ == kEmitStoreBarrier);
   }
 
+  void set_emit_store_barrier(StoreBarrierType value) {
+    emit_store_barrier_ = value;
+  }
+
   virtual bool ComputeCanDeoptimize() const { return false; }
 
   virtual Representation RequiredInputRepresentation(intptr_t idx) const;
@@ -4717,7 +4743,7 @@ class StoreIndexedInstr : public TemplateInstruction<3, NoThrow> {
     return Assembler::kValueCanBeSmi;
   }
 
-  const StoreBarrierType emit_store_barrier_;
+  StoreBarrierType emit_store_barrier_;
   const intptr_t index_scale_;
   const intptr_t class_id_;
   const AlignmentType alignment_;
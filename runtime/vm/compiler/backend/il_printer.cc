@@ -536,6 +536,9 @@ void InstanceCallInstr::PrintOperandsTo(BufferFormatter* f) const {
       PrintICDataHelper(f, *ic_data(), FlowGraphPrinter::kPrintAll);
     }
   }
+  if (dispatch_table_offset() != kNoDispatchTableOffset) {
+    f->Print(" DISPATCH TABLE %" Pd, dispatch_table_offset());
+  }
 }
 
 void PolymorphicInstanceCallInstr::PrintOperandsTo(BufferFormatter* f) const {
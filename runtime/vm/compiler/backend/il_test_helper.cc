@@ -0,0 +1,76 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/il_test_helper.h"
+
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/frontend/kernel_to_il.h"
+#include "vm/dart_api_impl.h"
+#include "vm/symbols.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+RawLibrary* LoadTestScript(const char* script) {
+  Dart_Handle api_lib;
+  {
+    TransitionVMToNative transition(Thread::Current());
+    api_lib = TestCase::LoadTestScript(script, NULL);
+    EXPECT_VALID(api_lib);
+  }
+  return Library::RawCast(Api::UnwrapHandle(api_lib));
+}
+
+RawFunction* GetFunction(const Library& lib, const char* name) {
+  Thread* thread = Thread::Current();
+  const Function& function = Function::Handle(
+      lib.LookupLocalFunction(String::Handle(Symbols::New(thread, name))));
+  EXPECT(!function.IsNull());
+  return function.raw();
+}
+
+void Invoke(const Library& lib, const char* name) {
+  Thread* thread = Thread::Current();
+  Dart_Handle api_lib = Api::NewHandle(thread, lib.raw());
+  TransitionVMToNative transition(thread);
+  Dart_Handle result =
+      Dart_Invoke(api_lib, NewString(name), /*argc=*/0, /*argv=*/NULL);
+  EXPECT_VALID(result);
+}
+
+static FlowGraph* BuildOptimizingGraph(const Function& function) {
+  Thread* thread = Thread::Current();
+  Zone* zone = thread->zone();
+  ParsedFunction* parsed_function = new (zone)
+      ParsedFunction(thread, Function::ZoneHandle(zone, function.raw()));
+  ZoneGrowableArray<const ICData*>* ic_data_array =
+      new (zone) ZoneGrowableArray<const ICData*>();
+  function.RestoreICDataMap(ic_data_array, /*clone_ic_data=*/false);
+  kernel::FlowGraphBuilder builder(parsed_function, ic_data_array, nullptr,
+                                   nullptr, /*optimizing=*/true,
+                                   DeoptId::kNone);
+  FlowGraph* flow_graph = builder.BuildGraph();
+  EXPECT(flow_graph != nullptr);
+  return flow_graph;
+}
+
+TestPipeline::TestPipeline(const Function& function)
+    : speculative_policy_(/*enable_blacklist=*/false),
+      flow_graph_(BuildOptimizingGraph(function)),
+      call_specializer_(flow_graph_, &speculative_policy_),
+      pass_state_(Thread::Current(), flow_graph_, &speculative_policy_) {
+  pass_state_.inline_id_to_function.Add(&flow_graph_->function());
+  pass_state_.caller_inline_id.Add(-1);
+  pass_state_.call_specializer = &call_specializer_;
+}
+
+FlowGraph* TestPipeline::RunPasses(
+    std::initializer_list<CompilerPass::Id> passes) {
+  for (const CompilerPass::Id pass : passes) {
+    CompilerPass::Get(pass)->Run(&pass_state_);
+  }
+  return flow_graph_;
+}
+
+}  // namespace dart
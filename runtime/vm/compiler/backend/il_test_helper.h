@@ -0,0 +1,74 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_IL_TEST_HELPER_H_
+#define RUNTIME_VM_COMPILER_BACKEND_IL_TEST_HELPER_H_
+
+#include <initializer_list>
+
+#include "vm/allocation.h"
+#include "vm/compiler/backend/inliner.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/compiler/jit/jit_call_specializer.h"
+#include "vm/object.h"
+
+// Helpers for unit tests which build the flow graph of a function in a test
+// script and run compiler passes on it:
+//
+//   TEST_CASE(MyPass_Works) {
+//     TransitionNativeToVM transition(thread);
+//     const auto& lib = Library::Handle(LoadTestScript(kScript));
+//     Invoke(lib, "main");
+//     const auto& function = Function::Handle(GetFunction(lib, "foo"));
+//
+//     CompilerState state(thread);
+//     TestPipeline pipeline(function);
+//     FlowGraph* flow_graph = pipeline.RunPasses({
+//         CompilerPass::kComputeSSA,
+//         CompilerPass::kTypePropagation,
+//     });
+//     ...
+//   }
+//
+// All of them are called from within the VM, not from native code.
+
+namespace dart {
+
+class FlowGraph;
+
+// Loads the given script into a new library and returns it.
+RawLibrary* LoadTestScript(const char* script);
+
+// Returns the top-level function of [lib] with the given name.
+RawFunction* GetFunction(const Library& lib, const char* name);
+
+// Calls the top-level function of [lib] with the given name and no
+// arguments, which for example collects type feedback for the functions it
+// calls.
+void Invoke(const Library& lib, const char* name);
+
+// Builds the optimizing flow graph of a function, using the type feedback
+// collected so far, and runs JIT compiler passes on it.
+class TestPipeline : public ValueObject {
+ public:
+  explicit TestPipeline(const Function& function);
+
+  // Runs [passes] in order on the flow graph and returns it. Later calls
+  // continue from where the previous ones stopped.
+  FlowGraph* RunPasses(std::initializer_list<CompilerPass::Id> passes);
+
+  FlowGraph* flow_graph() const { return flow_graph_; }
+
+ private:
+  SpeculativeInliningPolicy speculative_policy_;
+  FlowGraph* flow_graph_;
+  JitCallSpecializer call_specializer_;
+  CompilerPassState pass_state_;
+
+  DISALLOW_COPY_AND_ASSIGN(TestPipeline);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_IL_TEST_HELPER_H_
@@ -83,6 +83,15 @@ DEFINE_FLAG(int,
             10,
             "Inline only hotter calls, in percents (0 .. 100); "
             "default 10%: calls above-equal 10% of max-count are inlined.");
+DEFINE_FLAG(int,
+            inlining_hot_edge_frequency,
+            50,
+            "Calls executed at least this often, in percents of the hottest "
+            "call of the optimized function, may be inlined deeper.");
+DEFINE_FLAG(int,
+            inlining_hot_depth_extension,
+            2,
+            "Additional nesting depth allowed for inlining hot calls.");
 DEFINE_FLAG(int,
             inlining_recursion_depth_threshold,
             1,
@@ -267,6 +276,8 @@ class CallSites : public ValueObject {
   struct InstanceCallInfo {
     PolymorphicInstanceCallInstr* call;
     double ratio;
+    double frequency;
+    intptr_t index;
     const FlowGraph* caller_graph;
     intptr_t nesting_depth;
     InstanceCallInfo(PolymorphicInstanceCallInstr* call_arg,
@@ -274,6 +285,8 @@ class CallSites : public ValueObject {
                      intptr_t depth)
         : call(call_arg),
           ratio(0.0),
+          frequency(0.0),
+          index(0),
           caller_graph(flow_graph),
           nesting_depth(depth) {}
     const Function& caller() const { return caller_graph->function(); }
@@ -282,6 +295,8 @@ class CallSites : public ValueObject {
   struct StaticCallInfo {
     StaticCallInstr* call;
     double ratio;
+    double frequency;
+    intptr_t index;
     FlowGraph* caller_graph;
     intptr_t nesting_depth;
     StaticCallInfo(StaticCallInstr* value,
@@ -289,6 +304,8 @@ class CallSites : public ValueObject {
                    intptr_t depth)
         : call(value),
           ratio(0.0),
+          frequency(0.0),
+          index(0),
           caller_graph(flow_graph),
           nesting_depth(depth) {}
     const Function& caller() const { return caller_graph->function(); }
@@ -296,9 +313,12 @@ class CallSites : public ValueObject {
 
   struct ClosureCallInfo {
     ClosureCallInstr* call;
+    double frequency;
     FlowGraph* caller_graph;
-    ClosureCallInfo(ClosureCallInstr* value, FlowGraph* flow_graph)
-        : call(value), caller_graph(flow_graph) {}
+    ClosureCallInfo(ClosureCallInstr* value,
+                    FlowGraph* flow_graph,
+                    double graph_frequency)
+        : call(value), frequency(graph_frequency), caller_graph(flow_graph) {}
     const Function& caller() const { return caller_graph->function(); }
   };
 
@@ -330,6 +350,20 @@ class CallSites : public ValueObject {
     instance_calls_.Clear();
   }
 
+  // Orders the call sites hottest first, so that the size budget of the
+  // caller is spent on the most frequently executed calls. Call sites that
+  // are equally hot keep the order in which they were collected.
+  void SortByFrequency() {
+    for (intptr_t i = 0; i < static_calls_.length(); i++) {
+      static_calls_[i].index = i;
+    }
+    static_calls_.Sort(CompareByFrequency<StaticCallInfo>);
+    for (intptr_t i = 0; i < instance_calls_.length(); i++) {
+      instance_calls_[i].index = i;
+    }
+    instance_calls_.Sort(CompareByFrequency<InstanceCallInfo>);
+  }
+
   // Heuristic that maps the loop nesting depth to a static estimate of number
   // of times code at that depth is executed (code at each higher nesting
   // depth is assumed to execute 10x more often up to depth 3).
@@ -349,12 +383,26 @@ class CallSites : public ValueObject {
     }
   }
 
+  template <typename T>
+  static int CompareByFrequency(const T* a, const T* b) {
+    if (a->frequency != b->frequency) {
+      return (a->frequency > b->frequency) ? -1 : 1;
+    }
+    // The sort is not stable, break ties by the collection order.
+    return (a->index < b->index) ? -1 : ((a->index > b->index) ? 1 : 0);
+  }
+
   // Computes the ratio for each call site in a method, defined as the
   // number of times a call site is executed over the maximum number of
   // times any call site is executed in the method. JIT uses actual call
   // counts whereas AOT uses a static estimate based on nesting depth.
+  // The frequency of a call site is its ratio scaled by the frequency of
+  // the call the method is inlined at, which estimates how often the call
+  // site executes relative to the hottest call site of the function being
+  // optimized.
   void ComputeCallSiteRatio(intptr_t static_call_start_ix,
-                            intptr_t instance_call_start_ix) {
+                            intptr_t instance_call_start_ix,
+                            double graph_frequency) {
     const intptr_t num_static_calls =
         static_calls_.length() - static_call_start_ix;
     const intptr_t num_instance_calls =
@@ -389,6 +437,8 @@ class CallSites : public ValueObject {
               ? 0.0
               : static_cast<double>(instance_call_counts[i]) / max_count;
       instance_calls_[i + instance_call_start_ix].ratio = ratio;
+      instance_calls_[i + instance_call_start_ix].frequency =
+          ratio * graph_frequency;
     }
     for (intptr_t i = 0; i < num_static_calls; ++i) {
       const double ratio =
@@ -396,6 +446,8 @@ class CallSites : public ValueObject {
               ? 0.0
               : static_cast<double>(static_call_counts[i]) / max_count;
       static_calls_[i + static_call_start_ix].ratio = ratio;
+      static_calls_[i + static_call_start_ix].frequency =
+          ratio * graph_frequency;
     }
   }
 
@@ -431,11 +483,48 @@ class CallSites : public ValueObject {
     }
   }
 
+  static bool IsHot(double frequency) {
+    return (frequency * 100) >= FLAG_inlining_hot_edge_frequency;
+  }
+
+  // Calls inside of a hot inlined method may be inlined deeper than the
+  // nesting depth threshold, as long as they are hot themselves. Only the
+  // JIT has call counts to tell hot calls apart: the AOT estimate gives
+  // every call of a method without loops the ratio 1.
+  intptr_t DepthThresholdFor(double graph_frequency) const {
+    return (!FLAG_precompiled_mode && IsHot(graph_frequency))
+               ? inlining_depth_threshold_ + FLAG_inlining_hot_depth_extension
+               : inlining_depth_threshold_;
+  }
+
+  // Removes the call sites collected after the given start indices that are
+  // not hot.
+  void RemoveColdCallSites(intptr_t static_call_start_ix,
+                           intptr_t instance_call_start_ix) {
+    intptr_t j = static_call_start_ix;
+    for (intptr_t i = static_call_start_ix; i < static_calls_.length(); i++) {
+      if (IsHot(static_calls_[i].frequency)) {
+        static_calls_[j++] = static_calls_[i];
+      }
+    }
+    static_calls_.TruncateTo(j);
+    j = instance_call_start_ix;
+    for (intptr_t i = instance_call_start_ix; i < instance_calls_.length();
+         i++) {
+      if (IsHot(instance_calls_[i].frequency)) {
+        instance_calls_[j++] = instance_calls_[i];
+      }
+    }
+    instance_calls_.TruncateTo(j);
+  }
+
   void FindCallSites(FlowGraph* graph,
                      intptr_t depth,
+                     double graph_frequency,
                      GrowableArray<InlinedInfo>* inlined_info) {
     ASSERT(graph != NULL);
-    if (depth > inlining_depth_threshold_) {
+    const intptr_t depth_threshold = DepthThresholdFor(graph_frequency);
+    if (depth > depth_threshold) {
       if (FLAG_print_inlining_tree) {
         RecordAllNotInlinedFunction(graph, depth, inlined_info);
       }
@@ -444,8 +533,7 @@ class CallSites : public ValueObject {
 
     // Recognized methods are not treated as normal calls. They don't have
     // calls in themselves, so we keep adding those even when at the threshold.
-    const bool inline_only_recognized_methods =
-        (depth == inlining_depth_threshold_);
+    const bool inline_only_recognized_methods = (depth == depth_threshold);
 
     // In AOT, compute loop hierarchy.
     if (FLAG_precompiled_mode) {
@@ -496,12 +584,17 @@ class CallSites : public ValueObject {
         } else if (current->IsClosureCall()) {
           if (!inline_only_recognized_methods) {
             ClosureCallInstr* closure_call = current->AsClosureCall();
-            closure_calls_.Add(ClosureCallInfo(closure_call, graph));
+            closure_calls_.Add(
+                ClosureCallInfo(closure_call, graph, graph_frequency));
           }
         }
       }
     }
-    ComputeCallSiteRatio(static_call_start_ix, instance_call_start_ix);
+    ComputeCallSiteRatio(static_call_start_ix, instance_call_start_ix,
+                         graph_frequency);
+    if (depth > inlining_depth_threshold_) {
+      RemoveColdCallSites(static_call_start_ix, instance_call_start_ix);
+    }
   }
 
  private:
@@ -754,6 +847,7 @@ class CallSiteInliner : public ValueObject {
         inlining_depth_(1),
         inlining_recursion_depth_(0),
         inlining_depth_threshold_(threshold),
+        call_site_frequency_(1.0),
         collected_call_sites_(NULL),
         inlining_call_sites_(NULL),
         function_cache_(),
@@ -837,6 +931,7 @@ class CallSiteInliner : public ValueObject {
     inlining_call_sites_ = &sites2;
     // Collect initial call sites.
     collected_call_sites_->FindCallSites(caller_graph_, inlining_depth_,
+                                         /*graph_frequency=*/1.0,
                                          &inlined_info_);
     while (collected_call_sites_->HasCalls()) {
       TRACE_INLINING(
@@ -855,6 +950,7 @@ class CallSiteInliner : public ValueObject {
       collected_call_sites_ = inlining_call_sites_;
       inlining_call_sites_ = call_sites_temp;
       collected_call_sites_->Clear();
+      inlining_call_sites_->SortByFrequency();
       // Inline call sites at the current depth.
       bool inlined_instance = InlineInstanceCalls();
       bool inlined_statics = InlineStaticCalls();
@@ -1267,6 +1363,7 @@ class CallSiteInliner : public ValueObject {
         const intptr_t depth =
             function.IsDispatcherOrImplicitAccessor() ? 0 : inlining_depth_;
         collected_call_sites_->FindCallSites(callee_graph, depth,
+                                             call_site_frequency_,
                                              &inlined_info_);
 
         // Add the function to the cache.
@@ -1493,6 +1590,7 @@ class CallSiteInliner : public ValueObject {
                                 FLAG_optimization_level <= 2 &&
                                 !inliner_->AlwaysInline(target) &&
                                 call_info[call_idx].nesting_depth == 0;
+      call_site_frequency_ = call_info[call_idx].frequency;
       if (TryInlining(call->function(), call->argument_names(), &call_data,
                       stricter_heuristic)) {
         InlineCall(&call_data);
@@ -1547,6 +1645,7 @@ class CallSiteInliner : public ValueObject {
           call, arguments_descriptor, call->FirstArgIndex(), &arguments,
           call_info[call_idx].caller(),
           call_info[call_idx].caller_graph->inlining_id());
+      call_site_frequency_ = call_info[call_idx].frequency;
       if (TryInlining(target, call->argument_names(), &call_data, false)) {
         InlineCall(&call_data);
         inlined = true;
@@ -1574,6 +1673,7 @@ class CallSiteInliner : public ValueObject {
       intptr_t caller_inlining_id =
           call_info[call_idx].caller_graph->inlining_id();
       PolymorphicInliner inliner(this, call, cl, caller_inlining_id);
+      call_site_frequency_ = call_info[call_idx].frequency;
       if (inliner.Inline()) inlined = true;
     }
     return inlined;
@@ -1683,6 +1783,9 @@ class CallSiteInliner : public ValueObject {
   intptr_t inlining_depth_;
   intptr_t inlining_recursion_depth_;
   intptr_t inlining_depth_threshold_;
+  // Frequency of the call site currently being inlined, see
+  // CallSites::ComputeCallSiteRatio.
+  double call_site_frequency_;
   CallSites* collected_call_sites_;
   CallSites* inlining_call_sites_;
   GrowableArray<ParsedFunction*> function_cache_;
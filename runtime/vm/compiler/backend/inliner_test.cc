@@ -0,0 +1,108 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/inliner.h"
+
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/jit/compiler.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+DECLARE_FLAG(int, inlining_depth_threshold);
+DECLARE_FLAG(int, inlining_hot_depth_extension);
+
+// Runs 'main' of the given script, then compiles 'foo' with optimizations
+// and returns the names of the functions inlined into it, in the order in
+// which they were inlined, as ";name1;name2;...;".
+static const char* CompileAndListInlined(Thread* thread,
+                                         const char* script_chars) {
+  TransitionNativeToVM transition(thread);
+  Zone* zone = thread->zone();
+  const Library& lib = Library::Handle(zone, LoadTestScript(script_chars));
+  Invoke(lib, "main");
+  const Function& function = Function::Handle(zone, GetFunction(lib, "foo"));
+
+  const Object& code = Object::Handle(
+      zone, Compiler::CompileOptimizedFunction(thread, function));
+  EXPECT(code.IsCode());
+  if (!code.IsCode()) {
+    return "";
+  }
+  const Array& inlined =
+      Array::Handle(zone, Code::Cast(code).inlined_id_to_function());
+  char buffer[1024];
+  BufferFormatter f(buffer, sizeof(buffer));
+  Function& inlined_function = Function::Handle(zone);
+  String& inlined_name = String::Handle(zone);
+  f.Print(";");
+  // The first entry is 'foo' itself.
+  for (intptr_t i = 1; i < inlined.Length(); i++) {
+    inlined_function ^= inlined.At(i);
+    inlined_name = inlined_function.name();
+    f.Print("%s;", inlined_name.ToCString());
+  }
+  return zone->MakeCopyOfString(buffer);
+}
+
+static const char* kCallChainScript =
+    "int f4(int x) => x + 4;\n"
+    "int f3(int x) => f4(x) + 3;\n"
+    "int f2(int x) => f3(x) + 2;\n"
+    "int f1(int x) => f2(x) + 1;\n"
+    "int foo(int x) => f1(x);\n"
+    "main() {\n"
+    "  for (int i = 0; i < 10; i++) {\n"
+    "    foo(i);\n"
+    "  }\n"
+    "}\n";
+
+static bool Contains(const char* haystack, const char* needle) {
+  return strstr(haystack, needle) != NULL;
+}
+
+// Hot calls are inlined up to --inlining_hot_depth_extension levels deeper
+// than --inlining_depth_threshold.
+TEST_CASE(Inliner_HotCallsAreInlinedDeeper) {
+  SetFlagScope<int> depth(&FLAG_inlining_depth_threshold, 2);
+  SetFlagScope<int> extension(&FLAG_inlining_hot_depth_extension, 2);
+  const char* inlined = CompileAndListInlined(thread, kCallChainScript);
+  EXPECT(Contains(inlined, ";f1;"));
+  EXPECT(Contains(inlined, ";f2;"));
+  EXPECT(Contains(inlined, ";f3;"));
+  EXPECT(!Contains(inlined, ";f4;"));
+}
+
+TEST_CASE(Inliner_NoHotDepthExtension) {
+  SetFlagScope<int> depth(&FLAG_inlining_depth_threshold, 2);
+  SetFlagScope<int> extension(&FLAG_inlining_hot_depth_extension, 0);
+  const char* inlined = CompileAndListInlined(thread, kCallChainScript);
+  EXPECT(Contains(inlined, ";f1;"));
+  EXPECT(!Contains(inlined, ";f2;"));
+}
+
+// Equally hot calls are inlined in the order in which they appear.
+TEST_CASE(Inliner_EquallyHotCallsKeepOrder) {
+  const char* kScript =
+      "int a(int x) => x + 1;\n"
+      "int b(int x) => x + 2;\n"
+      "int c(int x) => x + 3;\n"
+      "int d(int x) => x + 4;\n"
+      "int foo(int x) => a(x) + b(x) + c(x) + d(x);\n"
+      "main() {\n"
+      "  for (int i = 0; i < 10; i++) {\n"
+      "    foo(i);\n"
+      "  }\n"
+      "}\n";
+  const char* inlined = CompileAndListInlined(thread, kScript);
+  const char* a = strstr(inlined, ";a;");
+  const char* b = strstr(inlined, ";b;");
+  const char* c = strstr(inlined, ";c;");
+  const char* d = strstr(inlined, ";d;");
+  EXPECT((a != NULL) && (b != NULL) && (c != NULL) && (d != NULL));
+  EXPECT((a < b) && (b < c) && (c < d));
+}
+
+}  // namespace dart
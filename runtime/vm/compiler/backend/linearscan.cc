@@ -2402,6 +2402,31 @@ void FlowGraphAllocator::AllocateAnyRegister(LiveRange* unallocated) {
 
   ASSERT(candidate != kNoRegister);
 
+  // Inside of a loop prefer a register whose occupants are not used in the
+  // loop: their spills are moved to the loop header (see SpillAfter) instead
+  // of adding memory traffic to the loop body.
+  LoopInfo* loop_info = BlockEntryAt(unallocated->Start())->loop_info();
+  if ((loop_info != nullptr) &&
+      !IsCheapToEvictRegisterInLoop(loop_info, candidate)) {
+    for (int reg = 0; reg < NumberOfRegisters(); ++reg) {
+      if (blocked_registers_[reg] || (reg == candidate)) continue;
+      intptr_t reg_free_until = 0;
+      intptr_t reg_blocked_at = kMaxPosition;
+      if (UpdateFreeUntil(reg, unallocated, &reg_free_until,
+                          &reg_blocked_at) &&
+          (reg_free_until >= register_use_pos) &&
+          (reg_blocked_at >= blocked_at) &&
+          IsCheapToEvictRegisterInLoop(loop_info, reg)) {
+        TRACE_ALLOC(THR_Print("preferring cheap to evict register "));
+        TRACE_ALLOC(MakeRegisterLocation(reg).Print());
+        TRACE_ALLOC(THR_Print(" in loop %" Pd "\n", loop_info->id()));
+        candidate = reg;
+        blocked_at = reg_blocked_at;
+        break;
+      }
+    }
+  }
+
   TRACE_ALLOC(THR_Print("assigning blocked register "));
   TRACE_ALLOC(MakeRegisterLocation(candidate).Print());
   TRACE_ALLOC(THR_Print(" to live range v%" Pd " until %" Pd "\n",
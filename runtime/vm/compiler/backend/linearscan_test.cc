@@ -0,0 +1,85 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/linearscan.h"
+
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/jit/compiler.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+// On most targets the values live in the loop do not fit into registers, so
+// registers have to be taken from other live ranges: the loop invariant
+// values 'p' to 'u' are only used after the loop. All loop variables start
+// out as the same constant, so the parallel move on loop entry stores it
+// into registers and, for the spilled phis, into stack slots.
+static const char* kScript =
+    "int foo(int n) {\n"
+    "  var a = 0, b = 0, c = 0, d = 0, e = 0, f = 0, g = 0, h = 0;\n"
+    "  var p = n + 1, q = n + 2, r = n + 3, s = n + 4, t = n + 5, u = n + 6;\n"
+    "  for (var i = 0; i < n; i++) {\n"
+    "    a += i;\n"
+    "    b += a ^ i;\n"
+    "    c += b & 0xff;\n"
+    "    d += c + a;\n"
+    "    e += d & 0xfff;\n"
+    "    f += e ^ b;\n"
+    "    g += f & 0xffff;\n"
+    "    h += g - c;\n"
+    "  }\n"
+    "  return a + b + c + d + e + f + g + h + p + q + r + s + t + u;\n"
+    "}\n"
+    "main() {\n"
+    "  for (var i = 0; i < 10; i++) {\n"
+    "    foo(i);\n"
+    "  }\n"
+    "}\n";
+
+static int64_t Foo(int64_t n) {
+  int64_t a = 0, b = 0, c = 0, d = 0, e = 0, f = 0, g = 0, h = 0;
+  for (int64_t i = 0; i < n; i++) {
+    a += i;
+    b += a ^ i;
+    c += b & 0xff;
+    d += c + a;
+    e += d & 0xfff;
+    f += e ^ b;
+    g += f & 0xffff;
+    h += g - c;
+  }
+  return a + b + c + d + e + f + g + h + 6 * n + 21;
+}
+
+// Optimized code for a loop with high register pressure computes the same
+// values as unoptimized code.
+TEST_CASE(LinearScan_RegisterPressureInLoop) {
+  Dart_Handle script = TestCase::LoadTestScript(kScript, NULL);
+  Dart_Handle result = Dart_Invoke(script, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+
+  {
+    TransitionNativeToVM transition(thread);
+    const Library& lib =
+        Library::Handle(Library::RawCast(Api::UnwrapHandle(script)));
+    const Function& function = Function::Handle(GetFunction(lib, "foo"));
+    const Object& code =
+        Object::Handle(Compiler::CompileOptimizedFunction(thread, function));
+    EXPECT(code.IsCode());
+    EXPECT(function.HasOptimizedCode());
+  }
+
+  const int64_t kInputs[] = {0, 1, 7, 100, 1000};
+  for (size_t i = 0; i < ARRAY_SIZE(kInputs); i++) {
+    Dart_Handle args[] = {Dart_NewInteger(kInputs[i])};
+    result = Dart_Invoke(script, NewString("foo"), 1, args);
+    EXPECT_VALID(result);
+    int64_t value = 0;
+    EXPECT_VALID(Dart_IntegerToInt64(result, &value));
+    EXPECT_EQ(Foo(kInputs[i]), value);
+  }
+}
+
+}  // namespace dart
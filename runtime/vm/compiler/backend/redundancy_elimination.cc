@@ -252,17 +252,18 @@ class Place : public ValueObject {
   //    - for places that depend on an instance X.f, X.@offs, X[i], X[C]
   //      we drop X if X is not an allocation because in this case X does not
   //      possess an identity obtaining aliases *.f, *.@offs, *[i] and *[C]
-  //      respectively;
+  //      respectively (AliasedSet tells whether X is an allocation, see
+  //      AliasedSet::ToAlias);
   //    - for non-constant indexed places X[i] we drop information about the
   //      index obtaining alias X[*].
   //    - we drop information about representation, but keep element size
   //      if any.
   //
-  Place ToAlias() const {
-    return Place(
-        RepresentationBits::update(kNoRepresentation, flags_),
-        (DependsOnInstance() && IsAllocation(instance())) ? instance() : NULL,
-        (kind() == kIndexed) ? 0 : raw_selector_);
+  Place ToAlias(bool instance_is_allocation) const {
+    return Place(RepresentationBits::update(kNoRepresentation, flags_),
+                 (DependsOnInstance() && instance_is_allocation) ? instance()
+                                                                 : NULL,
+                 (kind() == kIndexed) ? 0 : raw_selector_);
   }
 
   bool DependsOnInstance() const {
@@ -288,6 +289,12 @@ class Place : public ValueObject {
     return Place(flags_, NULL, raw_selector_);
   }
 
+  // Given alias X.f return Y.f.
+  Place CopyWithInstance(Definition* instance) const {
+    ASSERT(kind() == kInstanceField);
+    return Place(flags_, instance, raw_selector_);
+  }
+
   // Given alias X[C] or *[C] return X[*] and *[*] respectively.
   Place CopyWithoutIndex() const {
     ASSERT(kind() == kConstantIndexed);
@@ -634,6 +641,7 @@ class PhiPlaceMoves : public ZoneAllocated {
 class AliasedSet : public ZoneAllocated {
  public:
   AliasedSet(Zone* zone,
+             FlowGraph* graph,
              DirectChainedHashMap<PointerKeyValueTrait<Place> >* places_map,
              ZoneGrowableArray<Place*>* places,
              PhiPlaceMoves* phi_moves)
@@ -646,7 +654,10 @@ class AliasedSet : public ZoneAllocated {
         typed_data_access_sizes_(),
         representatives_(),
         killed_(),
-        aliased_by_effects_(new (zone) BitVector(zone, places->length())) {
+        aliased_by_effects_(new (zone) BitVector(zone, places->length())),
+        allocation_phis_(
+            new (zone) BitVector(zone, graph->current_ssa_temp_index())) {
+    ComputeAllocationPhis(graph);
     InsertAlias(Place::CreateAnyInstanceAnyIndexAlias(
         zone_, kAnyInstanceAnyIndexAlias));
     for (intptr_t i = 0; i < places_.length(); i++) {
@@ -688,6 +699,25 @@ class AliasedSet : public ZoneAllocated {
 
   const PhiPlaceMoves* phi_moves() const { return phi_moves_; }
 
+  // Like Place::IsAllocation, but also accepts phis that merge allocations.
+  bool IsAllocation(Definition* defn) const {
+    if (Place::IsAllocation(defn)) {
+      return true;
+    }
+    if ((defn == NULL) || !defn->IsPhi() || !defn->HasSSATemp()) {
+      return false;
+    }
+    const intptr_t index = defn->ssa_temp_index();
+    return (index < allocation_phis_->length()) &&
+           allocation_phis_->Contains(index);
+  }
+
+  // Returns the least generic alias of the given place (see Place::ToAlias).
+  Place ToAlias(const Place& place) const {
+    return place.ToAlias(place.DependsOnInstance() &&
+                         IsAllocation(place.instance()));
+  }
+
   void RollbackAliasedIdentites() {
     for (intptr_t i = 0; i < identity_rollback_.length(); ++i) {
       identity_rollback_[i]->SetIdentity(AliasIdentity::Unknown());
@@ -697,7 +727,7 @@ class AliasedSet : public ZoneAllocated {
   // Returns false if the result of an allocation instruction can't be aliased
   // by another SSA variable and true otherwise.
   bool CanBeAliased(Definition* alloc) {
-    if (!Place::IsAllocation(alloc)) {
+    if (!IsAllocation(alloc)) {
       return true;
     }
 
@@ -731,7 +761,7 @@ class AliasedSet : public ZoneAllocated {
   // Compute least generic alias for the place and assign alias id to it.
   void AddRepresentative(Place* place) {
     if (!place->IsImmutableField()) {
-      const Place* alias = CanonicalizeAlias(place->ToAlias());
+      const Place* alias = CanonicalizeAlias(ToAlias(*place));
       EnsureSet(&representatives_, alias->id())->Add(place->id());
 
       // Update cumulative representative sets that are used during
@@ -925,6 +955,14 @@ class AliasedSet : public ZoneAllocated {
           // X.f alias with *.f.
           CrossAlias(alias, alias->CopyWithoutInstance());
         }
+        if ((alias->instance() != NULL) && alias->instance()->IsPhi()) {
+          // P.f aliases with X.f for every allocation X merged by P.
+          PhiInstr* phi = alias->instance()->AsPhi();
+          for (intptr_t i = 0; i < phi->InputCount(); i++) {
+            CrossAlias(alias,
+                       alias->CopyWithInstance(phi->InputAt(i)->definition()));
+          }
+        }
         break;
 
       case Place::kNone:
@@ -976,8 +1014,19 @@ class AliasedSet : public ZoneAllocated {
           instr->IsCheckedSmiComparison() ||
           (instr->IsStoreIndexed() &&
            (use->use_index() == StoreIndexedInstr::kValuePos)) ||
-          instr->IsStoreStaticField() || instr->IsPhi()) {
+          instr->IsStoreStaticField()) {
         return true;
+      } else if (instr->IsPhi()) {
+        // Merging the object with other allocations does not create an alias
+        // unless the merged value escapes.
+        PhiInstr* phi = instr->AsPhi();
+        if (!IsAllocation(phi) || phi->Identity().IsAliased()) {
+          return true;
+        }
+        if (phi->Identity().IsUnknown()) {
+          phi->SetIdentity(AliasIdentity::NotAliased());
+          aliasing_worklist_.Add(phi);
+        }
       } else if ((instr->IsAssertAssignable() || instr->IsRedefinition()) &&
                  AnyUseCreatesAlias(instr->AsDefinition())) {
         return true;
@@ -990,8 +1039,7 @@ class AliasedSet : public ZoneAllocated {
         StoreInstanceFieldInstr* store = instr->AsStoreInstanceField();
         Definition* instance =
             store->instance()->definition()->OriginalDefinition();
-        if (Place::IsAllocation(instance) &&
-            !instance->Identity().IsAliased()) {
+        if (IsAllocation(instance) && !instance->Identity().IsAliased()) {
           bool is_load, is_store;
           Place store_place(instr, &is_load, &is_store);
 
@@ -1038,9 +1086,108 @@ class AliasedSet : public ZoneAllocated {
     }
   }
 
+  void MarkAliased(Definition* defn) {
+    if (!defn->Identity().IsAliased()) {
+      defn->SetIdentity(AliasIdentity::Aliased());
+      identity_rollback_.Add(defn);
+      aliasing_worklist_.Add(defn);
+    }
+  }
+
+  // A phi that merges allocations and its inputs refer to the same objects:
+  // if any of them escapes all of them do.
+  void LinkMergedAllocations(Definition* defn) {
+    if (PhiInstr* phi = defn->AsPhi()) {
+      for (intptr_t i = 0; i < phi->InputCount(); i++) {
+        Definition* input = phi->InputAt(i)->definition();
+        if (phi->Identity().IsAliased()) {
+          MarkAliased(input);
+        } else if (input->Identity().IsAliased()) {
+          MarkAliased(phi);
+        } else if (input->Identity().IsUnknown()) {
+          input->SetIdentity(AliasIdentity::NotAliased());
+          aliasing_worklist_.Add(input);
+        }
+      }
+    }
+
+    if (defn->Identity().IsAliased()) {
+      for (Value* use = defn->input_use_list(); use != NULL;
+           use = use->next_use()) {
+        PhiInstr* phi = use->instruction()->AsPhi();
+        if ((phi != NULL) && IsAllocation(phi)) {
+          MarkAliased(phi);
+        }
+      }
+    }
+  }
+
+  // A phi that merges object allocations is an allocation itself if no input
+  // can be observed through its own SSA value once the phi has been reached.
+  // This holds if the input does not dominate the phi (the input is allocated
+  // again before any of its uses that are reachable from the phi) or if all
+  // other uses of the input are in its own block. The phi and its inputs
+  // escape together and fields of the phi alias fields of its inputs.
+  //
+  // The answer depends on the uses of the inputs, so it is computed once for
+  // all phis when the set is created rather than on every query.
+  void ComputeAllocationPhis(FlowGraph* graph) {
+    for (BlockIterator block_it = graph->reverse_postorder_iterator();
+         !block_it.Done(); block_it.Advance()) {
+      JoinEntryInstr* join = block_it.Current()->AsJoinEntry();
+      if (join == NULL) {
+        continue;
+      }
+      for (PhiIterator it(join); !it.Done(); it.Advance()) {
+        PhiInstr* phi = it.Current();
+        if (phi->HasSSATemp() && MergesAllocations(phi)) {
+          allocation_phis_->Add(phi->ssa_temp_index());
+        }
+      }
+    }
+  }
+
+  static bool MergesAllocations(PhiInstr* phi) {
+    for (intptr_t i = 0; i < phi->InputCount(); i++) {
+      Definition* input = phi->InputAt(i)->definition();
+      if (!input->IsAllocateObject()) {
+        return false;
+      }
+      BlockEntryInstr* block = input->GetBlock();
+      if (block->Dominates(phi->block()) &&
+          !HasUsesOnlyInBlock(input, block, phi)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Returns true if all uses of the given definition and of its redefinitions
+  // other than the given phi are in the given block.
+  static bool HasUsesOnlyInBlock(Definition* defn,
+                                 BlockEntryInstr* block,
+                                 PhiInstr* phi) {
+    for (Value* use = defn->input_use_list(); use != NULL;
+         use = use->next_use()) {
+      Instruction* instr = use->instruction();
+      if (instr == phi) {
+        continue;
+      }
+      if (instr->IsPhi() || (instr->GetBlock() != block)) {
+        return false;
+      }
+      if ((instr->IsRedefinition() || instr->IsAssertAssignable() ||
+           instr->IsCheckNull()) &&
+          !HasUsesOnlyInBlock(instr->AsDefinition(), block, phi)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   // Determine if the given definition can't be aliased.
   void ComputeAliasing(Definition* alloc) {
-    ASSERT(Place::IsAllocation(alloc));
+    ASSERT(IsAllocation(alloc));
     ASSERT(alloc->Identity().IsUnknown());
     ASSERT(aliasing_worklist_.is_empty());
 
@@ -1049,7 +1196,7 @@ class AliasedSet : public ZoneAllocated {
 
     while (!aliasing_worklist_.is_empty()) {
       Definition* defn = aliasing_worklist_.RemoveLast();
-      ASSERT(Place::IsAllocation(defn));
+      ASSERT(IsAllocation(defn));
       // If the definition in the worklist was optimistically marked as
       // not-aliased check that optimistic assumption still holds: check if
       // any of its uses can create an alias.
@@ -1058,6 +1205,8 @@ class AliasedSet : public ZoneAllocated {
         identity_rollback_.Add(defn);
       }
 
+      LinkMergedAllocations(defn);
+
       // If the allocation site is marked as aliased conservatively mark
       // any values stored into the object aliased too.
       if (defn->Identity().IsAliased()) {
@@ -1094,6 +1243,10 @@ class AliasedSet : public ZoneAllocated {
   // explicit stores (i.e. through calls).
   BitVector* aliased_by_effects_;
 
+  // Phis that merge allocations, indexed by SSA temp index. Phis created
+  // after the set was built are not part of it.
+  BitVector* allocation_phis_;
+
   // Worklist used during alias analysis.
   GrowableArray<Definition*> aliasing_worklist_;
 
@@ -1225,7 +1378,7 @@ static AliasedSet* NumberPlaces(
   PhiPlaceMoves* phi_moves = ComputePhiMoves(map, places);
 
   // Build aliasing sets mapping aliases to loads.
-  return new (zone) AliasedSet(zone, map, places, phi_moves);
+  return new (zone) AliasedSet(zone, graph, map, places, phi_moves);
 }
 
 // Load instructions handled by load elimination.
@@ -1554,7 +1707,7 @@ class LoadOptimizer : public ValueObject {
         BitVector* killed = NULL;
         if (is_store) {
           const intptr_t alias_id =
-              aliased_set_->LookupAliasId(place.ToAlias());
+              aliased_set_->LookupAliasId(aliased_set_->ToAlias(place));
           if (alias_id != AliasedSet::kNoAlias) {
             killed = aliased_set_->GetKilledSet(alias_id);
           } else if (!place.IsImmutableField()) {
@@ -1575,8 +1728,9 @@ class LoadOptimizer : public ValueObject {
             // In this case we fallback to using place id recorded in the
             // instruction that still points to the old place with a more
             // generic alias.
-            const intptr_t old_alias_id = aliased_set_->LookupAliasId(
-                aliased_set_->places()[instr->place_id()]->ToAlias());
+            const intptr_t old_alias_id =
+                aliased_set_->LookupAliasId(aliased_set_->ToAlias(
+                    *aliased_set_->places()[instr->place_id()]));
             killed = aliased_set_->GetKilledSet(old_alias_id);
           }
 
@@ -2547,7 +2701,8 @@ class StoreOptimizer : public LivenessAnalysis {
         // Handle loads.
         Definition* defn = instr->AsDefinition();
         if ((defn != NULL) && IsLoadEliminationCandidate(defn)) {
-          const intptr_t alias = aliased_set_->LookupAliasId(place.ToAlias());
+          const intptr_t alias =
+              aliased_set_->LookupAliasId(aliased_set_->ToAlias(place));
           live_in->AddAll(aliased_set_->GetKilledSet(alias));
           continue;
         }
@@ -0,0 +1,125 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/redundancy_elimination.h"
+
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/compiler/compiler_state.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+DECLARE_FLAG(int, inlining_callee_size_threshold);
+
+// 'opaque' is too large to be inlined, so calls to it stay in the graph and
+// kill every field that can be reached from outside the function.
+static const char* kScript =
+    "class A {\n"
+    "  var f;\n"
+    "}\n"
+    "var global;\n"
+    "var sink;\n"
+    "opaque() {\n"
+    "  for (var i = 0; i < 3; i++) {\n"
+    "    sink = '$sink$i';\n"
+    "    sink = '$sink-$i';\n"
+    "  }\n"
+    "}\n"
+    "merged(c) {\n"
+    "  A a;\n"
+    "  if (c) {\n"
+    "    a = new A();\n"
+    "    a.f = 1;\n"
+    "  } else {\n"
+    "    a = new A();\n"
+    "    a.f = 2;\n"
+    "  }\n"
+    "  opaque();\n"
+    "  return a.f;\n"
+    "}\n"
+    "escapesOnOnePath(c) {\n"
+    "  A a;\n"
+    "  if (c) {\n"
+    "    a = new A();\n"
+    "    a.f = 1;\n"
+    "    global = a;\n"
+    "  } else {\n"
+    "    a = new A();\n"
+    "    a.f = 2;\n"
+    "  }\n"
+    "  opaque();\n"
+    "  return a.f;\n"
+    "}\n"
+    "main() {\n"
+    "  for (var i = 0; i < 10; i++) {\n"
+    "    merged(i.isEven);\n"
+    "    escapesOnOnePath(i.isEven);\n"
+    "  }\n"
+    "}\n";
+
+// Runs the JIT pipeline up to and including load forwarding on the given
+// function in kScript. Returns the number of loads of 'A.f' left in the
+// graph.
+static intptr_t CountLoadsOfFieldAfterCSE(const Library& lib,
+                                          const char* function_name) {
+  TestPipeline pipeline(Function::Handle(GetFunction(lib, function_name)));
+  FlowGraph* flow_graph = pipeline.RunPasses({
+      CompilerPass::kComputeSSA,
+      CompilerPass::kApplyICData,
+      CompilerPass::kTryOptimizePatterns,
+      CompilerPass::kSetOuterInliningId,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyClassIds,
+      CompilerPass::kInlining,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyClassIds,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kBranchSimplify,
+      CompilerPass::kIfConvert,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kConstantPropagation,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kCSE,
+  });
+
+  intptr_t loads = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      LoadFieldInstr* load = it.Current()->AsLoadField();
+      if ((load != nullptr) && load->slot().IsDartField() &&
+          (strcmp(load->slot().Name(), "f") == 0)) {
+        loads++;
+      }
+    }
+  }
+  return loads;
+}
+
+// A load through a phi of two allocations that never escape is forwarded
+// across a call, while the load stays if one of the allocations escapes on
+// its path.
+TEST_CASE(LoadOptimizer_AllocationPhi) {
+  SetFlagScope<int> callee_size(&FLAG_inlining_callee_size_threshold, 20);
+  TransitionNativeToVM transition(thread);
+  const Library& lib = Library::Handle(LoadTestScript(kScript));
+  Invoke(lib, "main");
+
+  {
+    CompilerState state(thread);
+    EXPECT_EQ(0, CountLoadsOfFieldAfterCSE(lib, "merged"));
+  }
+  {
+    CompilerState state(thread);
+    EXPECT_EQ(1, CountLoadsOfFieldAfterCSE(lib, "escapesOnOnePath"));
+  }
+}
+
+}  // namespace dart
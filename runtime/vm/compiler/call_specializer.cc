@@ -1547,6 +1547,93 @@ void CallSpecializer::VisitLoadCodeUnits(LoadCodeUnitsInstr* instr) {
 #endif
 }
 
+static bool IsNonEscapingAllocationHelper(Definition* alloc, intptr_t depth) {
+  const intptr_t kMaxDepth = 4;
+  if (depth > kMaxDepth) {
+    return false;
+  }
+  for (Value* use = alloc->input_use_list(); use != nullptr;
+       use = use->next_use()) {
+    Instruction* instr = use->instruction();
+    if (instr->IsLoadField() || instr->IsCloneContext()) {
+      continue;
+    }
+    if (StoreInstanceFieldInstr* store = instr->AsStoreInstanceField()) {
+      if (use == store->instance()) {
+        continue;
+      }
+      Definition* instance = store->instance()->definition();
+      if ((instance->IsAllocateObject() || instance->IsAllocateContext() ||
+           instance->IsAllocateUninitializedContext() ||
+           instance->IsCloneContext()) &&
+          IsNonEscapingAllocationHelper(instance, depth + 1)) {
+        continue;
+      }
+    }
+    return false;
+  }
+  return true;
+}
+
+bool CallSpecializer::IsNonEscapingAllocation(Definition* alloc) {
+  return IsNonEscapingAllocationHelper(alloc, 0);
+}
+
+// Replace generic context allocation or cloning with a sequence of inlined
+// allocation and explicit initializing stores.
+// If context_value is not NULL then newly allocated context is a populated
+// with values copied from it, otherwise it is initialized with null.
+void CallSpecializer::LowerContextAllocation(
+    Definition* alloc,
+    const GrowableArray<LocalVariable*>& context_variables,
+    Value* context_value) {
+  ASSERT(alloc->IsAllocateContext() || alloc->IsCloneContext());
+
+  AllocateUninitializedContextInstr* replacement =
+      new AllocateUninitializedContextInstr(alloc->token_pos(),
+                                            context_variables.length());
+  alloc->ReplaceWith(replacement, current_iterator());
+
+  Instruction* cursor = replacement;
+
+  Value* initial_value;
+  if (context_value != NULL) {
+    LoadFieldInstr* load =
+        new (Z) LoadFieldInstr(context_value->CopyWithType(Z),
+                               Slot::Context_parent(), alloc->token_pos());
+    flow_graph()->InsertAfter(cursor, load, NULL, FlowGraph::kValue);
+    cursor = load;
+    initial_value = new (Z) Value(load);
+  } else {
+    initial_value = new (Z) Value(flow_graph()->constant_null());
+  }
+  StoreInstanceFieldInstr* store = new (Z) StoreInstanceFieldInstr(
+      Slot::Context_parent(), new (Z) Value(replacement), initial_value,
+      kNoStoreBarrier, alloc->token_pos(),
+      StoreInstanceFieldInstr::Kind::kInitializing);
+  flow_graph()->InsertAfter(cursor, store, nullptr, FlowGraph::kEffect);
+  cursor = replacement;
+
+  for (auto variable : context_variables) {
+    const auto& field = Slot::GetContextVariableSlotFor(thread(), *variable);
+    if (context_value != nullptr) {
+      LoadFieldInstr* load = new (Z) LoadFieldInstr(
+          context_value->CopyWithType(Z), field, alloc->token_pos());
+      flow_graph()->InsertAfter(cursor, load, nullptr, FlowGraph::kValue);
+      cursor = load;
+      initial_value = new (Z) Value(load);
+    } else {
+      initial_value = new (Z) Value(flow_graph()->constant_null());
+    }
+
+    store = new (Z) StoreInstanceFieldInstr(
+        field, new (Z) Value(replacement), initial_value, kNoStoreBarrier,
+        alloc->token_pos(), StoreInstanceFieldInstr::Kind::kInitializing);
+    flow_graph()->InsertAfter(cursor, store, nullptr, FlowGraph::kEffect);
+    cursor = store;
+  }
+}
+
 static bool CidTestResultsContains(const ZoneGrowableArray<intptr_t>& results,
                                    intptr_t test_cid) {
   for (intptr_t i = 0; i < results.length(); i += 2) {
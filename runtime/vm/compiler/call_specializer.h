@@ -56,6 +56,12 @@ class CallSpecializer : public FlowGraphVisitor {
 
   virtual void VisitStaticCall(StaticCallInstr* instr);
 
+  // Returns true if the given allocation is only accessed through its own
+  // fields or stored into other allocations that do not escape either. Such
+  // a context is left behind by closures that were inlined at all their call
+  // sites and can be removed by allocation sinking once it is lowered.
+  static bool IsNonEscapingAllocation(Definition* alloc);
+
   // TODO(dartbug.com/30633) these methods have nothing to do with
   // specialization of calls. They are here for historical reasons.
   // Find a better place for them.
@@ -117,6 +123,11 @@ class CallSpecializer : public FlowGraphVisitor {
  protected:
   void InlineImplicitInstanceGetter(Definition* call, const Field& field);
 
+  void LowerContextAllocation(
+      Definition* instr,
+      const GrowableArray<LocalVariable*>& context_variables,
+      Value* context_value);
+
   SpeculativeInliningPolicy* speculative_policy_;
   const bool should_clone_fields_;
 
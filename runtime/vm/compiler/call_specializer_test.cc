@@ -0,0 +1,139 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/call_specializer.h"
+
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/compiler/compiler_state.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+static const char* kScript =
+    "inlined(a) {\n"
+    "  var x = a;\n"
+    "  get() => x;\n"
+    "  return get() + get();\n"
+    "}\n"
+    "escaping(a) {\n"
+    "  var x = a;\n"
+    "  return () => x;\n"
+    "}\n"
+    "main() {\n"
+    "  for (var i = 0; i < 10; i++) {\n"
+    "    inlined(i);\n"
+    "    escaping(i)();\n"
+    "  }\n"
+    "}\n";
+
+// Returns the only context allocation left in the graph, or nullptr.
+static Definition* FindContextAllocation(FlowGraph* flow_graph) {
+  Definition* result = nullptr;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      Instruction* instr = it.Current();
+      if (instr->IsAllocateContext() ||
+          instr->IsAllocateUninitializedContext()) {
+        EXPECT(result == nullptr);
+        result = instr->AsDefinition();
+      }
+    }
+  }
+  return result;
+}
+
+// Returns the number of initializing stores into the given allocation.
+static intptr_t CountInitializingStores(Definition* alloc) {
+  intptr_t count = 0;
+  for (Value* use = alloc->input_use_list(); use != nullptr;
+       use = use->next_use()) {
+    StoreInstanceFieldInstr* store = use->instruction()->AsStoreInstanceField();
+    if ((store != nullptr) && (use == store->instance()) &&
+        store->is_initialization()) {
+      count++;
+    }
+  }
+  return count;
+}
+
+// ApplyICData runs again after inlining, as it does in AOT, where it lowers
+// the contexts of closures that were inlined at all their call sites.
+static FlowGraph* RunPassesThroughInlining(TestPipeline* pipeline) {
+  return pipeline->RunPasses({
+      CompilerPass::kComputeSSA,
+      CompilerPass::kApplyICData,
+      CompilerPass::kTryOptimizePatterns,
+      CompilerPass::kSetOuterInliningId,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyClassIds,
+      CompilerPass::kInlining,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyClassIds,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyICData,
+  });
+}
+
+static FlowGraph* RunPassesThroughSinking(TestPipeline* pipeline) {
+  return pipeline->RunPasses({
+      CompilerPass::kCanonicalize,
+      CompilerPass::kConstantPropagation,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kCSE,
+      CompilerPass::kDSE,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kEliminateDeadPhis,
+      CompilerPass::kCanonicalize,
+      CompilerPass::kAllocationSinking_Sink,
+  });
+}
+
+// The lowered context of a closure that is inlined at all its call sites does
+// not escape, and allocation sinking removes it.
+TEST_CASE(CallSpecializer_LowerContextAllocation_Inlined) {
+  TransitionNativeToVM transition(thread);
+  const Library& lib = Library::Handle(LoadTestScript(kScript));
+  Invoke(lib, "main");
+
+  CompilerState state(thread);
+  TestPipeline pipeline(Function::Handle(GetFunction(lib, "inlined")));
+  FlowGraph* flow_graph = RunPassesThroughInlining(&pipeline);
+
+  // The context is allocated inline and its parent and 'x' are stored
+  // explicitly.
+  Definition* context = FindContextAllocation(flow_graph);
+  EXPECT(context != nullptr);
+  EXPECT(context->IsAllocateUninitializedContext());
+  EXPECT_EQ(2, CountInitializingStores(context));
+  EXPECT(CallSpecializer::IsNonEscapingAllocation(context));
+
+  RunPassesThroughSinking(&pipeline);
+  EXPECT(FindContextAllocation(flow_graph) == nullptr);
+}
+
+// A context captured by a returned closure escapes.
+TEST_CASE(CallSpecializer_LowerContextAllocation_Escaping) {
+  TransitionNativeToVM transition(thread);
+  const Library& lib = Library::Handle(LoadTestScript(kScript));
+  Invoke(lib, "main");
+
+  CompilerState state(thread);
+  TestPipeline pipeline(Function::Handle(GetFunction(lib, "escaping")));
+  FlowGraph* flow_graph = RunPassesThroughInlining(&pipeline);
+
+  Definition* context = FindContextAllocation(flow_graph);
+  EXPECT(context != nullptr);
+  EXPECT_EQ(2, CountInitializingStores(context));
+  EXPECT(!CallSpecializer::IsNonEscapingAllocation(context));
+
+  RunPassesThroughSinking(&pipeline);
+  EXPECT(FindContextAllocation(flow_graph) != nullptr);
+}
+
+}  // namespace dart
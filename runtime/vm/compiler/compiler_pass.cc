@@ -403,11 +403,52 @@ COMPILER_PASS(ReorderBlocks, {
   }
 });
 
+// Guards only deoptimize in optimized code; the runtime call that updates the
+// field state is emitted in unoptimized code only.
+static bool CanTriggerGCInOptimizedCode(Instruction* instr) {
+  if (instr->IsGuardFieldClass() || instr->IsGuardFieldLength() ||
+      instr->IsGuardFieldType()) {
+    return false;
+  }
+  return instr->CanTriggerGC();
+}
+
+// Returns the freshly allocated object known to be in new space (or in the
+// store buffer) on entry to 'block', or nullptr. The fact survives control
+// flow as long as every predecessor agrees on it. Predecessors reached through
+// a back edge have not been visited yet and conservatively clear it.
+static Definition* FreshAllocationOnEntry(
+    BlockEntryInstr* block,
+    const GrowableArray<Definition*>& fresh_on_exit) {
+  if (!block->IsTargetEntry() && !block->IsJoinEntry()) {
+    return nullptr;
+  }
+  if (block->IsIndirectEntry() || (block->PredecessorCount() == 0)) {
+    return nullptr;
+  }
+  Definition* fresh = nullptr;
+  for (intptr_t i = 0; i < block->PredecessorCount(); i++) {
+    BlockEntryInstr* pred = block->PredecessorAt(i);
+    if (pred->postorder_number() <= block->postorder_number()) {
+      return nullptr;
+    }
+    Definition* pred_fresh = fresh_on_exit[pred->postorder_number()];
+    if ((pred_fresh == nullptr) || ((i > 0) && (pred_fresh != fresh))) {
+      return nullptr;
+    }
+    fresh = pred_fresh;
+  }
+  return fresh;
+}
+
 static void WriteBarrierElimination(FlowGraph* flow_graph) {
+  GrowableArray<Definition*> fresh_on_exit(flow_graph->postorder().length());
+  fresh_on_exit.FillWith(nullptr, 0, flow_graph->postorder().length());
+
   for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
        !block_it.Done(); block_it.Advance()) {
     BlockEntryInstr* block = block_it.Current();
-    Definition* last_allocated = nullptr;
+    Definition* last_allocated = FreshAllocationOnEntry(block, fresh_on_exit);
     for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
       Instruction* current = it.Current();
       if (StoreInstanceFieldInstr* instr = current->AsStoreInstanceField()) {
@@ -419,16 +460,26 @@ static void WriteBarrierElimination(FlowGraph* flow_graph) {
         }
       }
 
+      // Filling a freshly created array, e.g. a list literal.
+      if (StoreIndexedInstr* instr = current->AsStoreIndexed()) {
+        if ((last_allocated != nullptr) && last_allocated->IsCreateArray() &&
+            (instr->array()->definition() == last_allocated)) {
+          instr->set_emit_store_barrier(kNoStoreBarrier);
+        }
+        continue;
+      }
+
       AllocationInstr* alloc = current->AsAllocation();
       if (alloc != nullptr && alloc->WillAllocateNewOrRemembered()) {
         last_allocated = alloc;
         continue;
       }
 
-      if (current->CanTriggerGC()) {
+      if (CanTriggerGCInOptimizedCode(current)) {
         last_allocated = nullptr;
       }
     }
+    fresh_on_exit[block->postorder_number()] = last_allocated;
   }
 }
 
@@ -733,25 +733,21 @@ void BytecodeFlowGraphBuilder::BuildInterfaceCall() {
     UNIMPLEMENTED();  // TODO(alexmarkov): interpreter
   }
 
-  const String& name = String::Cast(ConstantAt(DecodeOperandD()).value());
+  // The interpreter collects receiver classes in the call's ICData.
+  const ICData& icdata = ICData::Cast(ConstantAt(DecodeOperandD()).value());
+  ASSERT(ic_data_array_->At(icdata.deopt_id())->Original() == icdata.raw());
+
+  const String& name = String::ZoneHandle(Z, icdata.target_name());
   ASSERT(name.IsSymbol());
 
-  const Array& arg_desc_array =
-      Array::Cast(ConstantAt(DecodeOperandD(), 1).value());
-  const ArgumentsDescriptor arg_desc(arg_desc_array);
+  const ArgumentsDescriptor arg_desc(
+      Array::Handle(Z, icdata.arguments_descriptor()));
 
   const intptr_t argc = DecodeOperandA().value();
   Token::Kind token_kind = MethodTokenRecognizer::RecognizeTokenKind(name);
-
-  intptr_t checked_argument_count = 1;
-  if ((token_kind != Token::kILLEGAL) ||
+  if ((token_kind == Token::kILLEGAL) &&
       (name.raw() ==
-       Library::PrivateCoreLibName(Symbols::_simpleInstanceOf()).raw())) {
-    intptr_t argument_count = arg_desc.Count();
-    ASSERT(argument_count <= 2);
-    checked_argument_count = argument_count;
-  } else if (name.raw() ==
-             Library::PrivateCoreLibName(Symbols::_instanceOf()).raw()) {
+       Library::PrivateCoreLibName(Symbols::_instanceOf()).raw())) {
     token_kind = Token::kIS;
   }
 
@@ -759,10 +755,20 @@ void BytecodeFlowGraphBuilder::BuildInterfaceCall() {
 
   // TODO(alexmarkov): store interface_target in bytecode and pass it here.
 
+  // Several call sites may share the pool entry, so each call gets a deopt_id
+  // and an ICData of its own. Feedback recorded for this call site by
+  // unoptimized code is found in ic_data_array_; without it the call starts
+  // from a copy of the receiver classes the interpreter saw at the pool entry.
+  const intptr_t deopt_id = B->GetNextDeoptId();
   InstanceCallInstr* call = new (Z) InstanceCallInstr(
       position_, name, token_kind, arguments, arg_desc.TypeArgsLen(),
-      Array::ZoneHandle(Z, arg_desc.GetArgumentNames()), checked_argument_count,
-      *ic_data_array_, B->GetNextDeoptId());
+      Array::ZoneHandle(Z, arg_desc.GetArgumentNames()), icdata.NumArgsTested(),
+      *ic_data_array_, deopt_id);
+  if (!call->HasICData()) {
+    const ICData& call_icdata =
+        ICData::ZoneHandle(Z, ICData::CloneWithDeoptId(icdata, deopt_id));
+    call->set_ic_data(&call_icdata);
+  }
 
   // TODO(alexmarkov): add type info - call->SetResultType()
 
@@ -0,0 +1,142 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/frontend/bytecode_flow_graph_builder.h"
+
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/compiler_state.h"
+#include "vm/compiler/frontend/kernel_to_il.h"
+#include "vm/object.h"
+#include "vm/symbols.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+// The interpreter is supported only on x64 and arm64.
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+
+// Both calls in 'foo' share one InterfaceCall pool entry. 'main' calls 'foo'
+// few enough times for it to stay interpreted.
+static const char* kInterfaceCallScript =
+    "abstract class A {\n"
+    "  int get v;\n"
+    "}\n"
+    "class B implements A {\n"
+    "  int get v => 1;\n"
+    "}\n"
+    "class C implements A {\n"
+    "  int get v => 2;\n"
+    "}\n"
+    "int foo(A a, A b) => a.v + b.v;\n"
+    "main() {\n"
+    "  for (int i = 0; i < 3; i++) {\n"
+    "    foo(new B(), new C());\n"
+    "  }\n"
+    "}\n";
+
+// Runs 'main', builds the optimizing flow graph of 'foo' from bytecode with
+// the function's saved type feedback and checks the ICData of its 'get:v'
+// calls. When 'foo' was only interpreted, both calls are seeded from the
+// shared pool entry. Otherwise they use what unoptimized code recorded.
+static void CheckInterfaceCallICData(Thread* thread, bool interpreted) {
+  Dart_Handle script = TestCase::LoadTestScript(kInterfaceCallScript, NULL);
+  Dart_Handle result = Dart_Invoke(script, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+
+  TransitionNativeToVM transition(thread);
+  Zone* zone = thread->zone();
+  const Library& lib =
+      Library::Handle(zone, Library::RawCast(Api::UnwrapHandle(script)));
+  const String& name = String::Handle(zone, Symbols::New(thread, "foo"));
+  const Function& function =
+      Function::ZoneHandle(zone, lib.LookupLocalFunction(name));
+  EXPECT(!function.IsNull());
+  EXPECT(function.HasBytecode());
+  const String& getter = String::Handle(zone, Symbols::New(thread, "get:v"));
+
+  CompilerState state(thread);
+  ParsedFunction* parsed_function =
+      new (zone) ParsedFunction(thread, function);
+  ZoneGrowableArray<const ICData*>* ic_data_array =
+      new (zone) ZoneGrowableArray<const ICData*>();
+  function.RestoreICDataMap(ic_data_array, /*clone_ic_data=*/false);
+  kernel::FlowGraphBuilder builder(parsed_function, ic_data_array, nullptr,
+                                   nullptr, /*optimizing=*/true,
+                                   DeoptId::kNone);
+  FlowGraph* flow_graph = builder.BuildGraph();
+  EXPECT(flow_graph != nullptr);
+
+  const Bytecode& bytecode = Bytecode::Handle(zone, function.bytecode());
+  const ObjectPool& pool = ObjectPool::Handle(zone, bytecode.object_pool());
+  ICData& pool_icdata = ICData::Handle(zone);
+  Object& entry = Object::Handle(zone);
+  for (intptr_t i = 0; i < pool.Length(); i++) {
+    if (pool.TypeAt(i) != ObjectPool::EntryType::kTaggedObject) {
+      continue;
+    }
+    entry = pool.ObjectAt(i);
+    if (entry.IsICData() &&
+        (ICData::Cast(entry).target_name() == getter.raw())) {
+      EXPECT(pool_icdata.IsNull());
+      pool_icdata ^= entry.raw();
+    }
+  }
+  EXPECT(!pool_icdata.IsNull());
+
+  GrowableArray<InstanceCallInstr*> calls;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      InstanceCallInstr* call = it.Current()->AsInstanceCall();
+      if ((call != nullptr) && (call->function_name().raw() == getter.raw())) {
+        calls.Add(call);
+      }
+    }
+  }
+  EXPECT_EQ(2, calls.length());
+  if (calls.length() != 2) {
+    return;
+  }
+
+  for (intptr_t i = 0; i < calls.length(); i++) {
+    InstanceCallInstr* call = calls[i];
+    EXPECT(call->HasICData());
+    EXPECT(call->ic_data()->raw() != pool_icdata.raw());
+    EXPECT_EQ(call->deopt_id(), call->ic_data()->deopt_id());
+    if (interpreted) {
+      EXPECT_EQ(2, call->ic_data()->NumberOfChecks());
+    } else {
+      EXPECT(call->ic_data() == (*ic_data_array)[call->deopt_id()]);
+      // Each call site only ever saw one receiver class.
+      EXPECT_EQ(1, call->ic_data()->NumberOfChecks());
+    }
+  }
+  EXPECT(calls[0]->deopt_id() != calls[1]->deopt_id());
+  EXPECT(calls[0]->ic_data()->raw() != calls[1]->ic_data()->raw());
+  if (interpreted) {
+    EXPECT_EQ(2, pool_icdata.NumberOfChecks());
+  } else {
+    EXPECT(calls[0]->ic_data()->GetReceiverClassIdAt(0) !=
+           calls[1]->ic_data()->GetReceiverClassIdAt(0));
+  }
+}
+
+// Without feedback of their own, interface calls start from copies of the
+// interpreter's inline cache, one per call site.
+TEST_CASE(BytecodeInterfaceCall_SeedsICDataFromPool) {
+  SetFlagScope<bool> sfs(&FLAG_enable_interpreter, true);
+  CheckInterfaceCallICData(thread, /*interpreted=*/true);
+}
+
+// Feedback recorded for a call site by unoptimized code is used instead of
+// the shared inline cache of the pool entry.
+TEST_CASE(BytecodeInterfaceCall_PrefersCallSiteFeedback) {
+  SetFlagScope<bool> sfs(&FLAG_use_bytecode_compiler, true);
+  CheckInterfaceCallICData(thread, /*interpreted=*/false);
+}
+
+#endif  // defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+
+}  // namespace dart
@@ -328,6 +328,38 @@ void BytecodeReaderHelper::ReadTypeParametersDeclaration(
   }
 }
 
+// Binary operators and _simpleInstanceOf record the classes of all
+// arguments in their inline caches, other calls only the receiver class.
+static intptr_t CheckedArgumentCount(const String& name,
+                                     const Array& arg_desc,
+                                     const String& simple_instance_of) {
+  if ((MethodTokenRecognizer::RecognizeTokenKind(name) != Token::kILLEGAL) ||
+      (name.raw() == simple_instance_of.raw())) {
+    intptr_t argument_count = ArgumentsDescriptor(arg_desc).Count();
+    ASSERT(argument_count <= 2);
+    return argument_count;
+  }
+  return 1;
+}
+
+// Interface calls get an inline cache of their own, which replaces the
+// interpreter's global lookup cache while the call site is not megamorphic
+// and serves as type feedback when the function is compiled.
+RawICData* BytecodeReaderHelper::NewInterfaceCallICData(
+    const Function& function,
+    const String& name,
+    const Array& arg_desc,
+    const String** simple_instance_of) {
+  if (*simple_instance_of == nullptr) {
+    *simple_instance_of =
+        &Library::PrivateCoreLibName(Symbols::_simpleInstanceOf());
+  }
+  return ICData::New(function, name, arg_desc,
+                     H.thread()->compiler_state().GetNextDeoptId(),
+                     CheckedArgumentCount(name, arg_desc, **simple_instance_of),
+                     ICData::RebindRule::kInstance);
+}
+
 void BytecodeReaderHelper::ReadConstantPool(const Function& function,
                                             const ObjectPool& pool) {
   TIMELINE_DURATION(Thread::Current(), CompilerVerbose,
@@ -452,13 +484,9 @@ void BytecodeReaderHelper::ReadConstantPool(const Function& function,
               &Library::PrivateCoreLibName(Symbols::_simpleInstanceOf());
         }
         intptr_t checked_argument_count = 1;
-        if ((kind == InvocationKind::method) &&
-            ((MethodTokenRecognizer::RecognizeTokenKind(name) !=
-              Token::kILLEGAL) ||
-             (name.raw() == simpleInstanceOf->raw()))) {
-          intptr_t argument_count = ArgumentsDescriptor(array).Count();
-          ASSERT(argument_count <= 2);
-          checked_argument_count = argument_count;
+        if (kind == InvocationKind::method) {
+          checked_argument_count =
+              CheckedArgumentCount(name, array, *simpleInstanceOf);
         }
         // Do not mangle == or call:
         //   * operator == takes an Object so its either not checked or checked
@@ -640,10 +668,11 @@ void BytecodeReaderHelper::ReadConstantPool(const Function& function,
         ASSERT(arg_desc_index < i);
         array ^= pool.ObjectAt(arg_desc_index);
         // InterfaceCall constant occupies 2 entries.
-        // The first entry is used for selector name.
+        // The first entry is used for the inline cache.
         pool.SetTypeAt(i, ObjectPool::EntryType::kTaggedObject,
                        ObjectPool::Patchability::kNotPatchable);
-        pool.SetObjectAt(i, name);
+        obj = NewInterfaceCallICData(function, name, array, &simpleInstanceOf);
+        pool.SetObjectAt(i, obj);
         ++i;
         ASSERT(i < obj_count);
         // The second entry is used for arguments descriptor.
@@ -670,15 +699,17 @@ void BytecodeReaderHelper::ReadConstantPool(const Function& function,
         ASSERT(elem.IsFunction());
         name = Function::Cast(elem).name();
         ASSERT(name.IsSymbol());
+        array ^= ReadObject();
         // InterfaceCall constant occupies 2 entries.
-        // The first entry is used for selector name.
+        // The first entry is used for the inline cache.
         pool.SetTypeAt(i, ObjectPool::EntryType::kTaggedObject,
                        ObjectPool::Patchability::kNotPatchable);
-        pool.SetObjectAt(i, name);
+        obj = NewInterfaceCallICData(function, name, array, &simpleInstanceOf);
+        pool.SetObjectAt(i, obj);
         ++i;
         ASSERT(i < obj_count);
         // The second entry is used for arguments descriptor.
-        obj = ReadObject();
+        obj = array.raw();
       } break;
       default:
         UNREACHABLE();
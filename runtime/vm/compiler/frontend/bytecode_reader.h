@@ -87,6 +87,10 @@ class BytecodeReaderHelper : public ValueObject {
                                      intptr_t num_type_params);
 
   void ReadConstantPool(const Function& function, const ObjectPool& pool);
+  RawICData* NewInterfaceCallICData(const Function& function,
+                                    const String& name,
+                                    const Array& arg_desc,
+                                    const String** simple_instance_of);
   RawBytecode* ReadBytecode(const ObjectPool& pool);
   void ReadExceptionsTable(const Bytecode& bytecode, bool has_exceptions_table);
   void ReadSourcePositions(const Bytecode& bytecode, bool has_source_positions);
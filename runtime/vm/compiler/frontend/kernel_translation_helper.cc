@@ -2567,6 +2567,13 @@ const String& KernelReaderHelper::GetSourceFor(intptr_t index) {
   }
 }
 
+intptr_t KernelReaderHelper::SourceSizeFor(intptr_t index) {
+  AlternativeReadingScope alt(&reader_);
+  SetOffset(GetOffsetForSourceInfo(index));
+  SkipBytes(ReadUInt());  // skip uri.
+  return ReadUInt();      // read source List<byte> size.
+}
+
 RawTypedData* KernelReaderHelper::GetLineStartsFor(intptr_t index) {
   // Line starts are delta encoded. So get the max delta first so that we
   // can store them as tighly as possible.
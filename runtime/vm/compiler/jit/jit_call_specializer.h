@@ -30,11 +30,6 @@ class JitCallSpecializer : public CallSpecializer {
 
   virtual bool TryOptimizeStaticCallUsingStaticTypes(StaticCallInstr* call);
 
-  void LowerContextAllocation(
-      Definition* instr,
-      const GrowableArray<LocalVariable*>& context_variables,
-      Value* context_value);
-
   void ReplaceWithStaticCall(InstanceCallInstr* instr,
                              const ICData& unary_checks,
                              const Function& target);
@@ -7,6 +7,7 @@
 #if !defined(DART_PRECOMPILED_RUNTIME)
 
 #include "vm/dart_entry.h"
+#include "vm/heap/heap.h"
 #include "vm/longjump.h"
 #include "vm/native_arguments.h"
 #include "vm/native_entry.h"
@@ -17,6 +18,9 @@
 #include "vm/timeline.h"
 
 namespace dart {
+
+DECLARE_FLAG(int, pretenure_threshold);
+
 namespace compiler {
 
 bool IsSameObject(const Object& a, const Object& b) {
@@ -304,6 +308,12 @@ bool Class::TraceAllocation(const dart::Class& klass) {
   return klass.TraceAllocation(dart::Isolate::Current());
 }
 
+bool Class::MayBePretenured(const dart::Class& klass) {
+  // Only the JIT pretenures, and only instances of user classes.
+  return (FLAG_pretenure_threshold > 0) && !FLAG_precompiled_mode &&
+         (klass.id() >= kNumPredefinedCids);
+}
+
 word Instance::first_field_offset() {
   return dart::Instance::NextFieldOffset();
 }
@@ -484,6 +494,7 @@ word Array::header_size() {
   V(Thread, dart_stream_offset)                                                \
   V(Thread, end_offset)                                                        \
   V(Thread, global_object_pool_offset)                                         \
+  V(Thread, heap_offset)                                                       \
   V(Thread, isolate_offset)                                                    \
   V(Thread, marking_stack_block_offset)                                        \
   V(Thread, no_scope_native_wrapper_entry_point_offset)                        \
@@ -524,6 +535,15 @@ bool Heap::IsAllocatableInNewSpace(intptr_t instance_size) {
   return dart::Heap::IsAllocatableInNewSpace(instance_size);
 }
 
+word Heap::PretenuredCidOffsetFor(intptr_t cid) {
+  return dart::Heap::new_space_offset() +
+         dart::Scavenger::PretenuredCidOffsetFor(cid);
+}
+
+uint8_t Heap::PretenuredCidMaskFor(intptr_t cid) {
+  return dart::Scavenger::PretenuredCidMaskFor(cid);
+}
+
 #if !defined(TARGET_ARCH_DBC)
 word Thread::write_barrier_code_offset() {
   return dart::Thread::write_barrier_code_offset();
@@ -612,6 +632,10 @@ word Thread::invoke_dart_code_from_bytecode_stub_offset() {
   return dart::Thread::invoke_dart_code_from_bytecode_stub_offset();
 }
 
+word Thread::invoke_dart_osr_code_from_bytecode_stub_offset() {
+  return dart::Thread::invoke_dart_osr_code_from_bytecode_stub_offset();
+}
+
 word Thread::null_error_shared_without_fpu_regs_stub_offset() {
   return dart::Thread::null_error_shared_without_fpu_regs_stub_offset();
 }
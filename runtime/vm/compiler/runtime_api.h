@@ -388,6 +388,10 @@ class Class : public AllStatic {
 
   // Whether to trace allocation for this klass.
   static bool TraceAllocation(const dart::Class& klass);
+
+  // Whether the scavenger may decide to allocate instances of this klass in
+  // old space, in which case allocation stubs check if it currently does.
+  static bool MayBePretenured(const dart::Class& klass);
 };
 
 class Instance : public AllStatic {
@@ -556,6 +560,7 @@ class Thread : public AllStatic {
   static word top_offset();
   static word end_offset();
   static word isolate_offset();
+  static word heap_offset();
   static word store_buffer_block_offset();
   static word call_to_runtime_entry_point_offset();
   static word null_error_shared_with_fpu_regs_entry_point_offset();
@@ -581,6 +586,7 @@ class Thread : public AllStatic {
   static word invoke_dart_code_stub_offset();
   static word interpret_call_entry_point_offset();
   static word invoke_dart_code_from_bytecode_stub_offset();
+  static word invoke_dart_osr_code_from_bytecode_stub_offset();
   static word null_error_shared_without_fpu_regs_stub_offset();
   static word null_error_shared_with_fpu_regs_stub_offset();
   static word stack_overflow_shared_without_fpu_regs_stub_offset();
@@ -729,6 +735,11 @@ class Heap : public AllStatic {
   // Return true if an object with the given instance size is allocatable
   // in new space on the target.
   static bool IsAllocatableInNewSpace(intptr_t instance_size);
+
+  // Offset from the heap of the byte holding the pretenured bit of [cid],
+  // and the mask of that bit.
+  static word PretenuredCidOffsetFor(intptr_t cid);
+  static uint8_t PretenuredCidMaskFor(intptr_t cid);
 };
 
 class NativeArguments {
@@ -1219,6 +1219,12 @@ void StubCodeCompiler::GenerateInvokeDartCodeFromBytecodeStub(
 #endif  // defined(DART_PRECOMPILED_RUNTIME)
 }
 
+// The interpreter only moves activations into OSR code on X64 and ARM64.
+void StubCodeCompiler::GenerateInvokeDartOsrCodeFromBytecodeStub(
+    Assembler* assembler) {
+  __ Stop("Unimplemented");
+}
+
 // Called for inline allocation of contexts.
 // Input:
 //   R1: number of context variables.
@@ -1592,6 +1598,15 @@ void StubCodeCompiler::GenerateAllocationStubForClass(Assembler* assembler,
       target::Heap::IsAllocatableInNewSpace(instance_size) &&
       !target::Class::TraceAllocation(cls)) {
     Label slow_case;
+    if (target::Class::MayBePretenured(cls)) {
+      // Pretenured instances are allocated in old space by the runtime.
+      const intptr_t cid = target::Class::GetId(cls);
+      __ ldr(kEndReg, Address(THR, target::Thread::heap_offset()));
+      __ LoadFromOffset(kUnsignedByte, kEndReg, kEndReg,
+                        target::Heap::PretenuredCidOffsetFor(cid));
+      __ TestImmediate(kEndReg, target::Heap::PretenuredCidMaskFor(cid));
+      __ b(&slow_case, NE);
+    }
 
     // Allocate the object and update top to point to
     // next object start and initialize the allocated object.
@@ -1307,6 +1307,161 @@ void StubCodeCompiler::GenerateInvokeDartCodeFromBytecodeStub(
 #endif  // defined(DART_PRECOMPILED_RUNTIME)
 }
 
+// Input parameters:
+//   R1: address of a Smi count, followed by that many values.
+// Output:
+//   R1: address following the last value.
+// Clobbers R3 and R5.
+static void PushCountedValues(Assembler* assembler) {
+  Label push_values;
+  Label done_push_values;
+  __ ldr(R5, Address(R1, target::kWordSize, Address::PostIndex));
+  __ SmiUntag(R5);
+  __ cbz(&done_push_values, R5);
+  __ Bind(&push_values);
+  __ ldr(R3, Address(R1, target::kWordSize, Address::PostIndex));
+  __ Push(R3);
+  __ sub(R5, R5, Operand(1));
+  __ cbnz(&push_values, R5);
+  __ Bind(&done_push_values);
+}
+
+// Called when moving an interpreted activation, stopped at a loop stack check,
+// into optimized code compiled with an OSR entry at that check.
+// Input parameters:
+//   LR : points to return address.
+//   R0 : OSR code.
+//   R1 : address of the frame contents: Smi argument count, arguments,
+//        Smi local count, locals.
+//   R2 : current thread.
+void StubCodeCompiler::GenerateInvokeDartOsrCodeFromBytecodeStub(
+    Assembler* assembler) {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  __ Stop("Not using interpreter");
+#else
+  // Copy the C stack pointer (R31) into the stack pointer we'll actually use
+  // to access the stack.
+  __ SetupDartSP();
+  __ Push(LR);  // Marker for the profiler.
+  __ EnterFrame(0);
+
+  // Push code object to PC marker slot.
+  __ ldr(TMP,
+         Address(R2, target::Thread::
+                         invoke_dart_osr_code_from_bytecode_stub_offset()));
+  __ Push(TMP);
+
+  // Save the callee-saved registers.
+  for (int i = kAbiFirstPreservedCpuReg; i <= kAbiLastPreservedCpuReg; i++) {
+    const Register r = static_cast<Register>(i);
+    // We use str instead of the Push macro because we will be pushing the PP
+    // register when it is not holding a pool-pointer since we are coming from
+    // C++ code.
+    __ str(r, Address(SP, -1 * target::kWordSize, Address::PreIndex));
+  }
+
+  // Save the bottom 64-bits of callee-saved V registers.
+  for (int i = kAbiFirstPreservedFpuReg; i <= kAbiLastPreservedFpuReg; i++) {
+    const VRegister r = static_cast<VRegister>(i);
+    __ PushDouble(r);
+  }
+
+  // Set up THR, which caches the current thread in Dart code.
+  if (THR != R2) {
+    __ mov(THR, R2);
+  }
+  // Refresh write barrier mask.
+  __ ldr(BARRIER_MASK,
+         Address(THR, target::Thread::write_barrier_mask_offset()));
+
+  // Save the current VMTag on the stack.
+  __ LoadFromOffset(R4, THR, target::Thread::vm_tag_offset());
+  __ Push(R4);
+
+  // Save top resource and top exit frame info. Use R6 as a temporary register.
+  // StackFrameIterator reads the top exit frame info saved in this frame.
+  __ LoadFromOffset(R6, THR, target::Thread::top_resource_offset());
+  __ StoreToOffset(ZR, THR, target::Thread::top_resource_offset());
+  __ Push(R6);
+  __ LoadFromOffset(R6, THR, target::Thread::top_exit_frame_info_offset());
+  __ StoreToOffset(ZR, THR, target::Thread::top_exit_frame_info_offset());
+  // target::frame_layout.exit_link_slot_from_entry_fp must be kept in sync
+  // with the code below.
+  ASSERT(target::frame_layout.exit_link_slot_from_entry_fp == -22);
+  __ Push(R6);
+
+  // Mark that the thread is executing Dart code. Do this after initializing the
+  // exit link for the profiler.
+  __ LoadImmediate(R6, VMTag::kDartCompiledTagId);
+  __ StoreToOffset(R6, THR, target::Thread::vm_tag_offset());
+
+  // Push arguments. R1 points to the Smi argument count.
+  PushCountedValues(assembler);
+
+  // We now load the pool pointer(PP) with a GC safe value as we are about to
+  // invoke dart code. We don't need a real object pool here.
+  // Smi zero does not work because ARM64 assumes PP to be untagged.
+  __ LoadObject(PP, NullObject());
+
+  // Lay out the frame the way unoptimized code has it at the loop stack check.
+  // The OSR entry only restores CODE_REG and PP from it (see
+  // Assembler::EnterOsrFrame).
+  // R1: address of the Smi local count.
+  __ mov(CODE_REG, R0);
+  __ EnterFrame(0);
+  __ TagAndPushPPAndPcMarker();
+  PushCountedValues(assembler);
+
+  // Continue at the OSR entry. It returns through the LR slot saved by
+  // EnterFrame above, which must point right after the branch.
+  __ ldr(R0, FieldAddress(CODE_REG, target::Code::entry_point_offset()));
+  const intptr_t kReturnOffset = 3 * Instr::kInstrSize;
+  const intptr_t adr_position = assembler->CodeSize();
+  __ adr(LR, Immediate(kReturnOffset));
+  __ str(LR, Address(FP, 1 * target::kWordSize));
+  __ br(R0);
+  ASSERT(assembler->CodeSize() - adr_position == kReturnOffset);
+
+  // Get rid of arguments pushed on the stack.
+  __ AddImmediate(
+      SP, FP,
+      target::frame_layout.exit_link_slot_from_entry_fp * target::kWordSize);
+
+  // Restore the saved top exit frame info and top resource back into the
+  // Isolate structure. Uses R6 as a temporary register for this.
+  __ Pop(R6);
+  __ StoreToOffset(R6, THR, target::Thread::top_exit_frame_info_offset());
+  __ Pop(R6);
+  __ StoreToOffset(R6, THR, target::Thread::top_resource_offset());
+
+  // Restore the current VMTag from the stack.
+  __ Pop(R4);
+  __ StoreToOffset(R4, THR, target::Thread::vm_tag_offset());
+
+  // Restore the bottom 64-bits of callee-saved V registers.
+  for (int i = kAbiLastPreservedFpuReg; i >= kAbiFirstPreservedFpuReg; i--) {
+    const VRegister r = static_cast<VRegister>(i);
+    __ PopDouble(r);
+  }
+
+  // Restore C++ ABI callee-saved registers.
+  for (int i = kAbiLastPreservedCpuReg; i >= kAbiFirstPreservedCpuReg; i--) {
+    Register r = static_cast<Register>(i);
+    // We use ldr instead of the Pop macro because we will be popping the PP
+    // register when it is not holding a pool-pointer since we are returning to
+    // C++ code. We also skip the dart stack pointer SP, since we are still
+    // using it as the stack pointer.
+    __ ldr(r, Address(SP, 1 * target::kWordSize, Address::PostIndex));
+  }
+
+  // Restore the frame pointer and C stack pointer and return.
+  __ LeaveFrame();
+  __ Drop(1);
+  __ RestoreCSP();
+  __ ret();
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+}
+
 // Called for inline allocation of contexts.
 // Input:
 //   R1: number of context variables.
@@ -1662,6 +1817,16 @@ void StubCodeCompiler::GenerateAllocationStubForClass(Assembler* assembler,
       target::Heap::IsAllocatableInNewSpace(instance_size) &&
       !target::Class::TraceAllocation(cls)) {
     Label slow_case;
+    if (target::Class::MayBePretenured(cls)) {
+      // Pretenured instances are allocated in old space by the runtime.
+      const intptr_t cid = target::Class::GetId(cls);
+      __ ldr(kTempReg, Address(THR, target::Thread::heap_offset()));
+      __ LoadFromOffset(kTempReg, kTempReg,
+                        target::Heap::PretenuredCidOffsetFor(cid),
+                        kUnsignedByte);
+      __ TestImmediate(kTempReg, target::Heap::PretenuredCidMaskFor(cid));
+      __ b(&slow_case, NE);
+    }
     // Allocate the object & initialize header word.
     __ TryAllocate(cls, &slow_case, kInstanceReg, kTopReg,
                    /*tag_result=*/false);
@@ -136,6 +136,11 @@ void StubCodeCompiler::GenerateInvokeDartCodeFromBytecodeStub(
   __ Trap();
 }
 
+void StubCodeCompiler::GenerateInvokeDartOsrCodeFromBytecodeStub(
+    Assembler* assembler) {
+  __ Trap();
+}
+
 }  // namespace compiler
 
 }  // namespace dart
@@ -991,6 +991,12 @@ void StubCodeCompiler::GenerateInvokeDartCodeFromBytecodeStub(
   __ ret();
 }
 
+// The interpreter only moves activations into OSR code on X64 and ARM64.
+void StubCodeCompiler::GenerateInvokeDartOsrCodeFromBytecodeStub(
+    Assembler* assembler) {
+  __ Stop("Unimplemented");
+}
+
 // Called for inline allocation of contexts.
 // Input:
 // EDX: number of context variables.
@@ -1292,6 +1298,14 @@ void StubCodeCompiler::GenerateAllocationStubForClass(Assembler* assembler,
       target::Heap::IsAllocatableInNewSpace(instance_size) &&
       !target::Class::TraceAllocation(cls)) {
     Label slow_case;
+    if (target::Class::MayBePretenured(cls)) {
+      // Pretenured instances are allocated in old space by the runtime.
+      const intptr_t cid = target::Class::GetId(cls);
+      __ movl(ECX, Address(THR, target::Thread::heap_offset()));
+      __ testb(Address(ECX, target::Heap::PretenuredCidOffsetFor(cid)),
+               Immediate(target::Heap::PretenuredCidMaskFor(cid)));
+      __ j(NOT_ZERO, &slow_case);
+    }
     // Allocate the object and update top to point to
     // next object start and initialize the allocated object.
     // EDX: instantiated type arguments (if is_cls_parameterized).
@@ -1257,6 +1257,149 @@ void StubCodeCompiler::GenerateInvokeDartCodeFromBytecodeStub(
 #endif  // defined(DART_PRECOMPILED_RUNTIME)
 }
 
+// Input parameters:
+//   RDX: address of a Smi count, followed by that many values.
+// Output:
+//   RDX: address following the last value.
+// Clobbers RAX and RBX.
+static void PushCountedValues(Assembler* assembler) {
+  Label push_values;
+  Label done_push_values;
+  __ movq(RBX, Address(RDX, 0));
+  __ addq(RDX, Immediate(target::kWordSize));
+  __ SmiUntag(RBX);
+  __ j(ZERO, &done_push_values, Assembler::kNearJump);
+  __ LoadImmediate(RAX, Immediate(0));
+  __ Bind(&push_values);
+  __ pushq(Address(RDX, RAX, TIMES_8, 0));
+  __ incq(RAX);
+  __ cmpq(RAX, RBX);
+  __ j(LESS, &push_values, Assembler::kNearJump);
+  __ leaq(RDX, Address(RDX, RBX, TIMES_8, 0));
+  __ Bind(&done_push_values);
+}
+
+// Called when moving an interpreted activation, stopped at a loop stack check,
+// into optimized code compiled with an OSR entry at that check.
+// Input parameters:
+//   RSP : points to return address.
+//   RDI : OSR code.
+//   RSI : address of the frame contents: Smi argument count, arguments,
+//         Smi local count, locals.
+//   RDX : current thread.
+void StubCodeCompiler::GenerateInvokeDartOsrCodeFromBytecodeStub(
+    Assembler* assembler) {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  __ Stop("Not using interpreter");
+#else
+  __ pushq(Address(RSP, 0));  // Marker for the profiler.
+  __ EnterFrame(0);
+
+  const Register kOsrCodeReg = CallingConventions::kArg1Reg;
+  const Register kFrameContentsReg = CallingConventions::kArg2Reg;
+  const Register kThreadReg = CallingConventions::kArg3Reg;
+
+  // Push code object to PC marker slot.
+  __ pushq(Address(
+      kThreadReg,
+      target::Thread::invoke_dart_osr_code_from_bytecode_stub_offset()));
+
+  // Save the Smi argument count where InvokeDartCodeFromBytecode saves it, so
+  // that both stubs set up the same entry frame.
+  const intptr_t kArgumentsCountOffset = -2 * target::kWordSize;
+  __ pushq(Address(kFrameContentsReg, 0));
+
+  // Save C++ ABI callee-saved registers.
+  __ PushRegisters(CallingConventions::kCalleeSaveCpuRegisters,
+                   CallingConventions::kCalleeSaveXmmRegisters);
+
+  // Set up THR, which caches the current thread in Dart code.
+  if (THR != kThreadReg) {
+    __ movq(THR, kThreadReg);
+  }
+
+  // Save the current VMTag on the stack.
+  __ movq(RAX, Assembler::VMTagAddress());
+  __ pushq(RAX);
+
+  // Save top resource and top exit frame info. Use RAX as a temporary register.
+  // StackFrameIterator reads the top exit frame info saved in this frame.
+  __ movq(RAX, Address(THR, target::Thread::top_resource_offset()));
+  __ pushq(RAX);
+  __ movq(Address(THR, target::Thread::top_resource_offset()), Immediate(0));
+  __ movq(RAX, Address(THR, target::Thread::top_exit_frame_info_offset()));
+  __ pushq(RAX);
+  __ movq(Address(THR, target::Thread::top_exit_frame_info_offset()),
+          Immediate(0));
+
+#if defined(DEBUG)
+  {
+    Label ok;
+    __ leaq(RAX,
+            Address(RBP, target::frame_layout.exit_link_slot_from_entry_fp *
+                             target::kWordSize));
+    __ cmpq(RAX, RSP);
+    __ j(EQUAL, &ok);
+    __ Stop("target::frame_layout.exit_link_slot_from_entry_fp mismatch");
+    __ Bind(&ok);
+  }
+#endif
+
+  // Mark that the thread is executing Dart code. Do this after initializing the
+  // exit link for the profiler.
+  __ movq(Assembler::VMTagAddress(), Immediate(VMTag::kDartCompiledTagId));
+
+  // Push arguments. At this point we only need to preserve kOsrCodeReg.
+  ASSERT(kOsrCodeReg != RDX);
+  if (kFrameContentsReg != RDX) {
+    __ movq(RDX, kFrameContentsReg);
+  }
+  PushCountedValues(assembler);
+
+  // Call the OSR code.
+  Label enter_osr_frame;
+  __ xorq(PP, PP);  // GC-safe value into PP.
+  __ movq(CODE_REG, kOsrCodeReg);
+  __ call(&enter_osr_frame);
+
+  // Read the saved number of passed arguments as Smi.
+  __ movq(RDX, Address(RBP, kArgumentsCountOffset));
+
+  // Get rid of arguments pushed on the stack.
+  __ leaq(RSP, Address(RSP, RDX, TIMES_4, 0));  // RDX is a Smi.
+
+  // Restore the saved top exit frame info and top resource back into the
+  // Isolate structure.
+  __ popq(Address(THR, target::Thread::top_exit_frame_info_offset()));
+  __ popq(Address(THR, target::Thread::top_resource_offset()));
+
+  // Restore the current VMTag from the stack.
+  __ popq(Assembler::VMTagAddress());
+
+  // Restore C++ ABI callee-saved registers.
+  __ PopRegisters(CallingConventions::kCalleeSaveCpuRegisters,
+                  CallingConventions::kCalleeSaveXmmRegisters);
+  __ set_constant_pool_allowed(false);
+
+  // Restore the frame pointer.
+  __ LeaveFrame();
+  __ popq(RCX);
+
+  __ ret();
+
+  // Lay out the frame the way unoptimized code has it at the loop stack check
+  // and continue at the OSR entry, which only restores CODE_REG and PP from it
+  // (see Assembler::EnterOsrFrame).
+  // RDX: address of the Smi local count.
+  __ Bind(&enter_osr_frame);
+  __ EnterFrame(0);
+  __ pushq(CODE_REG);
+  __ pushq(PP);
+  PushCountedValues(assembler);
+  __ jmp(FieldAddress(CODE_REG, target::Code::entry_point_offset()));
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+}
+
 // Called for inline allocation of contexts.
 // Input:
 // R10: number of context variables.
@@ -1601,6 +1744,14 @@ void StubCodeCompiler::GenerateAllocationStubForClass(Assembler* assembler,
       target::Heap::IsAllocatableInNewSpace(instance_size) &&
       !target::Class::TraceAllocation(cls)) {
     Label slow_case;
+    if (target::Class::MayBePretenured(cls)) {
+      // Pretenured instances are allocated in old space by the runtime.
+      const intptr_t cid = target::Class::GetId(cls);
+      __ movq(TMP, Address(THR, target::Thread::heap_offset()));
+      __ testb(Address(TMP, target::Heap::PretenuredCidOffsetFor(cid)),
+               Immediate(target::Heap::PretenuredCidMaskFor(cid)));
+      __ j(NOT_ZERO, &slow_case);
+    }
     // Allocate the object and update top to point to
     // next object start and initialize the allocated object.
     // RDX: instantiated type arguments (if is_cls_parameterized).
@@ -0,0 +1,119 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/compiler/compiler_state.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+static const char* kScript =
+    "f(a) => a;\n"
+    "acrossBranch(a, b) => [a, b == null ? a : b, a];\n"
+    "callInBranch(a, b) => [a, b == null ? f(a) : b, a];\n"
+    "captured(a, b) {\n"
+    "  var x = b == null ? a : b;\n"
+    "  return () => x;\n"
+    "}\n"
+    "main() {\n"
+    "  acrossBranch(1, 2);\n"
+    "  callInBranch(1, 2);\n"
+    "  captured(1, 2);\n"
+    "}\n";
+
+// Converts the graph to SSA form with propagated types.
+static FlowGraph* BuildGraph(TestPipeline* pipeline) {
+  return pipeline->RunPasses({
+      CompilerPass::kComputeSSA,
+      CompilerPass::kTypePropagation,
+  });
+}
+
+// Returns the store of element 'index' into a list literal.
+static StoreIndexedInstr* FindElementStore(FlowGraph* flow_graph,
+                                           intptr_t index) {
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      StoreIndexedInstr* store = it.Current()->AsStoreIndexed();
+      if ((store != nullptr) && store->array()->definition()->IsCreateArray() &&
+          store->index()->BindsToConstant() &&
+          store->index()->BoundConstant().IsSmi() &&
+          (Smi::Cast(store->index()->BoundConstant()).Value() == index)) {
+        return store;
+      }
+    }
+  }
+  return nullptr;
+}
+
+TEST_CASE(WriteBarrierElimination_ListLiteral) {
+  TransitionNativeToVM transition(thread);
+  const Library& lib = Library::Handle(LoadTestScript(kScript));
+  Invoke(lib, "main");
+
+  // The branch between the element stores does not end the fresh-allocation
+  // fact, so none of the stores needs a barrier.
+  {
+    CompilerState state(thread);
+    TestPipeline pipeline(Function::Handle(GetFunction(lib, "acrossBranch")));
+    FlowGraph* flow_graph = BuildGraph(&pipeline);
+    for (intptr_t i = 0; i < 3; i++) {
+      StoreIndexedInstr* store = FindElementStore(flow_graph, i);
+      EXPECT(store != nullptr);
+      EXPECT(store->ShouldEmitStoreBarrier());
+    }
+    pipeline.RunPasses({CompilerPass::kWriteBarrierElimination});
+    for (intptr_t i = 0; i < 3; i++) {
+      EXPECT(!FindElementStore(flow_graph, i)->ShouldEmitStoreBarrier());
+    }
+  }
+
+  // A call on one path can trigger GC, so stores after the join keep their
+  // barriers while the store before the branch loses it.
+  {
+    CompilerState state(thread);
+    TestPipeline pipeline(Function::Handle(GetFunction(lib, "callInBranch")));
+    FlowGraph* flow_graph = BuildGraph(&pipeline);
+    pipeline.RunPasses({CompilerPass::kWriteBarrierElimination});
+    EXPECT(!FindElementStore(flow_graph, 0)->ShouldEmitStoreBarrier());
+    EXPECT(FindElementStore(flow_graph, 1)->ShouldEmitStoreBarrier());
+    EXPECT(FindElementStore(flow_graph, 2)->ShouldEmitStoreBarrier());
+  }
+}
+
+// The context is allocated on entry and its variable is stored after the
+// join of a conditional expression.
+TEST_CASE(WriteBarrierElimination_ContextAcrossBranch) {
+  TransitionNativeToVM transition(thread);
+  const Library& lib = Library::Handle(LoadTestScript(kScript));
+  Invoke(lib, "main");
+
+  CompilerState state(thread);
+  TestPipeline pipeline(Function::Handle(GetFunction(lib, "captured")));
+  FlowGraph* flow_graph = BuildGraph(&pipeline);
+  pipeline.RunPasses({CompilerPass::kWriteBarrierElimination});
+
+  intptr_t phi_stores = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      StoreInstanceFieldInstr* store = it.Current()->AsStoreInstanceField();
+      if ((store != nullptr) &&
+          store->instance()->definition()->IsAllocateContext() &&
+          store->value()->definition()->IsPhi()) {
+        EXPECT(!store->ShouldEmitStoreBarrier());
+        phi_stores++;
+      }
+    }
+  }
+  EXPECT_EQ(1, phi_stores);
+}
+
+}  // namespace dart
@@ -15,6 +15,7 @@
 #include "vm/heap/become.h"
 #include "vm/heap/freelist.h"
 #include "vm/heap/heap.h"
+#include "vm/heap/page_cache.h"
 #include "vm/heap/pointer_block.h"
 #include "vm/isolate.h"
 #include "vm/isolate_reload.h"
@@ -193,6 +194,7 @@ char* Dart::Init(const uint8_t* vm_isolate_snapshot,
   NativeSymbolResolver::Init();
   NOT_IN_PRODUCT(Profiler::Init());
   SemiSpace::Init();
+  PageCache::Init();
   NOT_IN_PRODUCT(Metric::Init());
   StoreBuffer::Init();
   MarkingStack::Init();
@@ -483,6 +485,8 @@ char* Dart::Cleanup() {
     OS::PrintErr("[+%" Pd64 "ms] SHUTDOWN: Deleting thread pool\n",
                  UptimeMillis());
   }
+  // Stop the page cache's decommit task before its thread pool goes away.
+  PageCache::Cleanup();
   delete thread_pool_;
   thread_pool_ = NULL;
 
@@ -522,6 +526,7 @@ char* Dart::Cleanup() {
   Object::Cleanup();
   SemiSpace::Cleanup();
   StubCode::Cleanup();
+  VirtualMemory::Cleanup();
   // Delete the current thread's TLS and set it's TLS to null.
   // If it is the last thread then the destructor would call
   // OSThread::Cleanup.
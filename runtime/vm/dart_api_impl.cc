@@ -33,6 +33,7 @@
 #include "vm/message_handler.h"
 #include "vm/native_entry.h"
 #include "vm/object.h"
+#include "vm/object_graph.h"
 #include "vm/object_store.h"
 #include "vm/os.h"
 #include "vm/os_thread.h"
@@ -1516,6 +1517,24 @@ DART_EXPORT void Dart_NotifyLowMemory() {
   Isolate::NotifyLowMemory();
 }
 
+DART_EXPORT void Dart_SetHeapGoals(int64_t max_pause_micros,
+                                   intptr_t heap_limit_percent,
+                                   intptr_t gc_time_percent) {
+  Thread* T = Thread::Current();
+  CHECK_ISOLATE(T->isolate());
+  intptr_t heap_limit_in_words = 0;
+  if (heap_limit_percent > 0) {
+    const int64_t memory_limit = OS::GetMemoryLimit();
+    heap_limit_in_words = static_cast<intptr_t>(
+        (memory_limit / 100) * Utils::Minimum(heap_limit_percent,
+                                              static_cast<intptr_t>(100)) /
+        kWordSize);
+  }
+  TransitionNativeToVM transition(T);
+  T->isolate()->heap()->SetGoals(max_pause_micros, heap_limit_in_words,
+                                 static_cast<int>(gc_time_percent));
+}
+
 DART_EXPORT void Dart_ExitIsolate() {
   Thread* T = Thread::Current();
   CHECK_ISOLATE(T->isolate());
@@ -5755,6 +5774,60 @@ DART_EXPORT Dart_Handle Dart_ServiceSendDataEvent(const char* stream_id,
   return Api::Success();
 }
 
+DART_EXPORT Dart_Handle
+Dart_WriteHeapSnapshot(Dart_StreamingWriteCallback callback,
+                       void* callback_data) {
+#if defined(PRODUCT)
+  return Api::NewError("%s: Heap snapshots are not supported in product mode.",
+                       CURRENT_FUNC);
+#else
+  DARTSCOPE(Thread::Current());
+  if (callback == NULL) {
+    RETURN_NULL_ERROR(callback);
+  }
+  StreamingWriteStream stream(1 * MB, callback, callback_data);
+  ObjectGraph graph(T);
+  graph.Serialize(&stream, ObjectGraph::kVM);
+  return Api::Success();
+#endif
+}
+
+DART_EXPORT Dart_Handle Dart_WriteProfile(Dart_ProfileKind kind,
+                                          int64_t time_origin_micros,
+                                          int64_t time_extent_micros,
+                                          Dart_StreamingWriteCallback callback,
+                                          void* callback_data) {
+#if defined(PRODUCT)
+  return Api::NewError("%s: Profiling is not supported in product mode.",
+                       CURRENT_FUNC);
+#else
+  DARTSCOPE(Thread::Current());
+  if (callback == NULL) {
+    RETURN_NULL_ERROR(callback);
+  }
+  Profile::PprofKind pprof_kind;
+  switch (kind) {
+    case Dart_ProfileKind_CPU:
+      pprof_kind = Profile::kCpuPprof;
+      break;
+    case Dart_ProfileKind_Allocation:
+      pprof_kind = Profile::kAllocationPprof;
+      break;
+    case Dart_ProfileKind_NativeAllocation:
+      pprof_kind = Profile::kNativeAllocationPprof;
+      break;
+    default:
+      return Api::NewError("%s: Invalid profile kind %d.", CURRENT_FUNC, kind);
+  }
+  if (!ProfilerService::WritePprof(pprof_kind, time_origin_micros,
+                                   time_extent_micros, callback,
+                                   callback_data)) {
+    return Api::NewError("%s: The profiler is disabled.", CURRENT_FUNC);
+  }
+  return Api::Success();
+#endif
+}
+
 DART_EXPORT char* Dart_SetFileModifiedCallback(
     Dart_FileModifiedCallback file_modified_callback) {
 #if !defined(PRODUCT)
@@ -5793,6 +5866,10 @@ DART_EXPORT bool Dart_IsReloading() {
 #endif
 }
 
+DART_EXPORT void Dart_SetGCEventCallback(Dart_GCEventCallback callback) {
+  GCTelemetry::set_callback(callback);
+}
+
 DART_EXPORT void Dart_GlobalTimelineSetRecordedStreams(int64_t stream_mask) {
 #if defined(SUPPORT_TIMELINE)
   const bool api_enabled = (stream_mask & DART_TIMELINE_STREAM_API) != 0;
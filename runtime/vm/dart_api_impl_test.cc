@@ -7751,6 +7751,35 @@ TEST_CASE(DartAPI_NotifyLowMemory) {
   EXPECT_VALID(result);
 }
 
+TEST_CASE(DartAPI_SetHeapGoals) {
+  const int64_t kMaxPauseMicros = 10 * kMicrosecondsPerMillisecond;
+  const int64_t memory_limit = OS::GetMemoryLimit();
+  Dart_SetHeapGoals(kMaxPauseMicros, 50, 5);
+  {
+    TransitionNativeToVM transition(thread);
+    Heap* heap = thread->isolate()->heap();
+    EXPECT_EQ(kMaxPauseMicros, heap->new_space()->max_pause_micros());
+    EXPECT_EQ(static_cast<intptr_t>((memory_limit / 100) * 50 / kWordSize),
+              heap->old_space()->heap_limit_in_words());
+  }
+
+  // The limit is at most all of the available memory.
+  Dart_SetHeapGoals(0, 200, 0);
+  {
+    TransitionNativeToVM transition(thread);
+    Heap* heap = thread->isolate()->heap();
+    EXPECT_EQ(0, heap->new_space()->max_pause_micros());
+    EXPECT_EQ(static_cast<intptr_t>((memory_limit / 100) * 100 / kWordSize),
+              heap->old_space()->heap_limit_in_words());
+  }
+
+  Dart_SetHeapGoals(0, 0, 0);
+  {
+    TransitionNativeToVM transition(thread);
+    EXPECT_EQ(0, thread->isolate()->heap()->old_space()->heap_limit_in_words());
+  }
+}
+
 // There exists another test by name DartAPI_Invoke_CrossLibrary.
 // However, that currently fails for the dartk configuration as it
 // uses Dart_LoadLibray. This test here effectively tests the same
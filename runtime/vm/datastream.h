@@ -499,7 +499,21 @@ class StreamingWriteStream : public ValueObject {
     cursor_ += size;
   }
 
+  void WriteUnsigned(intptr_t value) {
+    ASSERT((value >= 0) && (value <= kIntptrMax));
+    while (value > kMaxUnsignedDataPerByte) {
+      WriteByte(static_cast<uint8_t>(value & kByteMask));
+      value = value >> kDataBitsPerByte;
+    }
+    WriteByte(static_cast<uint8_t>(value + kEndUnsignedByteMarker));
+  }
+
  private:
+  DART_FORCE_INLINE void WriteByte(uint8_t value) {
+    EnsureAvailable(1);
+    *cursor_++ = value;
+  }
+
   void EnsureAvailable(intptr_t needed) {
     intptr_t available = limit_ - cursor_;
     if (available >= needed) return;
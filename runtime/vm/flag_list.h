@@ -78,6 +78,11 @@ constexpr bool kDartPrecompiledRuntime = false;
     "Deoptimizes we are about to return to Dart code from native entries.")    \
   C(deoptimize_every, 0, 0, int, 0,                                            \
     "Deoptimize on every N stack overflow checks")                             \
+  P(deserializer_min_concurrent_fill_kb, int, 256,                             \
+    "Snapshot fill sections smaller than this many KB are not split across "   \
+    "tasks.")                                                                  \
+  P(deserializer_tasks, int, USING_MULTICORE ? 2 : 0,                          \
+    "The number of tasks to use for filling objects when reading snapshots.")  \
   R(disable_alloc_stubs_after_gc, false, bool, false, "Stress testing flag.")  \
   R(disassemble, false, bool, false, "Disassemble dart code.")                 \
   R(disassemble_optimized, false, bool, false, "Disassemble optimized code.")  \
@@ -108,6 +113,8 @@ constexpr bool kDartPrecompiledRuntime = false;
   P(idle_duration_micros, int, 500 * kMicrosecondsPerMillisecond,              \
     "Allow idle tasks to run for this long.")                                  \
   P(interpret_irregexp, bool, USING_DBC, "Use irregexp bytecode interpreter")  \
+  P(kernel_loader_tasks, int, 0,                                               \
+    "The number of tasks to use for decoding kernel binaries while loading.")  \
   P(lazy_dispatchers, bool, true, "Generate dispatchers lazily")               \
   P(link_natives_lazily, bool, false, "Link native calls lazily")              \
   C(load_deferred_eagerly, true, true, bool, false,                            \
@@ -135,7 +135,8 @@ class CompactorTask : public ThreadPool::Task {
         freelist_(freelist),
         free_page_(NULL),
         free_current_(0),
-        free_end_(0) {}
+        free_end_(0),
+        live_bytes_(0) {}
 
  private:
   void Run();
@@ -155,6 +156,7 @@ class CompactorTask : public ThreadPool::Task {
   HeapPage* free_page_;
   uword free_current_;
   uword free_end_;
+  intptr_t live_bytes_;
 
   DISALLOW_COPY_AND_ASSIGN(CompactorTask);
 };
@@ -233,6 +235,7 @@ void GCCompactor::Compact(HeapPage* pages,
                           heap_->barrier_done());
     intptr_t next_forwarding_task = 0;
 
+    const int64_t start = OS::GetCurrentMonotonicMicros();
     for (intptr_t task_index = 0; task_index < num_tasks; task_index++) {
       Dart::thread_pool()->Run(new CompactorTask(
           thread()->isolate(), this, &barrier, &next_forwarding_task,
@@ -241,9 +244,15 @@ void GCCompactor::Compact(HeapPage* pages,
 
     // Plan pages.
     barrier.Sync();
+    const int64_t planned = OS::GetCurrentMonotonicMicros();
     // Slides pages. Forward large pages, new space, etc.
     barrier.Sync();
     barrier.Exit();
+    const int64_t slid = OS::GetCurrentMonotonicMicros();
+    heap_->telemetry()->AddPhaseTime(GCTelemetry::kCompactPlan,
+                                     planned - start);
+    heap_->telemetry()->AddPhaseTime(GCTelemetry::kCompactSlide,
+                                     slid - planned);
   }
 
   for (intptr_t task_index = 0; task_index < num_tasks; task_index++) {
@@ -252,7 +261,10 @@ void GCCompactor::Compact(HeapPage* pages,
 
   {
     TIMELINE_FUNCTION_GC_DURATION(thread(), "ForwardStackPointers");
+    const int64_t start = OS::GetCurrentMonotonicMicros();
     ForwardStackPointers();
+    heap_->telemetry()->AddPhaseTime(GCTelemetry::kCompactForwardStack,
+                                     OS::GetCurrentMonotonicMicros() - start);
   }
 
   {
@@ -296,6 +308,7 @@ void CompactorTask::Run() {
 #ifdef SUPPORT_TIMELINE
   Thread* thread = Thread::Current();
 #endif
+  const int64_t start = OS::GetCurrentMonotonicMicros();
   {
     {
       TIMELINE_FUNCTION_GC_DURATION(thread, "Plan");
@@ -382,6 +395,8 @@ void CompactorTask::Run() {
       }
     }
 
+    isolate_->heap()->telemetry()->AddTask(
+        "Compact", OS::GetCurrentMonotonicMicros() - start, live_bytes_);
     barrier_->Sync();
   }
   Thread::ExitIsolateAsHelper(true);
@@ -442,6 +457,7 @@ uword CompactorTask::PlanBlock(uword first_object,
   PlanMoveToContiguousSize(block_live_size);
   forwarding_block->set_new_address(free_current_);
   free_current_ += block_live_size;
+  live_bytes_ += block_live_size;
 
   return current;  // First object in the next block
 }
@@ -0,0 +1,138 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/heap/gc_telemetry.h"
+
+#include "vm/lockers.h"
+
+namespace dart {
+
+Dart_GCEventCallback GCTelemetry::callback_ = NULL;
+
+GCTelemetry::GCTelemetry() : tasks_mutex_(), tasks_(), concurrent_tasks_() {
+  Reset();
+}
+
+void GCTelemetry::Reset() {
+  for (intptr_t i = 0; i < kNumPhases; i++) {
+    phase_micros_[i] = 0;
+  }
+  for (intptr_t i = 0; i < kNumCounters; i++) {
+    counters_[i] = 0;
+  }
+  MutexLocker ml(&tasks_mutex_);
+  tasks_.Clear();
+}
+
+Dart_GCTask GCTelemetry::MakeTask(const char* name,
+                                  int64_t micros,
+                                  int64_t bytes) {
+  Dart_GCTask task;
+  task.name = name;
+  task.thread_id =
+      OSThread::ThreadIdToIntPtr(OSThread::GetCurrentThreadId());
+  task.micros = micros;
+  task.bytes = bytes;
+  return task;
+}
+
+void GCTelemetry::AddTask(const char* name, int64_t micros, int64_t bytes) {
+  MutexLocker ml(&tasks_mutex_);
+  tasks_.Add(MakeTask(name, micros, bytes));
+}
+
+void GCTelemetry::AddConcurrentTask(const char* name,
+                                    int64_t micros,
+                                    int64_t bytes) {
+  MutexLocker ml(&tasks_mutex_);
+  concurrent_tasks_.Add(MakeTask(name, micros, bytes));
+}
+
+const char* GCTelemetry::PhaseToString(Phase phase) {
+  switch (phase) {
+#define PHASE_NAME(name)                                                       \
+  case k##name:                                                                \
+    return #name;
+    GC_PHASE_LIST(PHASE_NAME)
+#undef PHASE_NAME
+    default:
+      UNREACHABLE();
+      return NULL;
+  }
+}
+
+const char* GCTelemetry::CounterToString(Counter counter) {
+  switch (counter) {
+#define COUNTER_NAME(name)                                                     \
+  case k##name:                                                                \
+    return #name;
+    GC_COUNTER_LIST(COUNTER_NAME)
+#undef COUNTER_NAME
+    default:
+      UNREACHABLE();
+      return NULL;
+  }
+}
+
+void GCTelemetry::Report(const char* isolate_name,
+                         const char* type,
+                         const char* reason,
+                         int64_t start_micros,
+                         int64_t end_micros,
+                         bool is_old_space) {
+  Dart_GCEventCallback callback = GCTelemetry::callback();
+  if (callback == NULL) {
+    if (is_old_space) {
+      MutexLocker ml(&tasks_mutex_);
+      concurrent_tasks_.Clear();
+    }
+    return;
+  }
+
+  Dart_GCMetric phases[kNumPhases];
+  intptr_t num_phases = 0;
+  for (intptr_t i = 0; i < kNumPhases; i++) {
+    if (phase_micros_[i] != 0) {
+      phases[num_phases].name = PhaseToString(static_cast<Phase>(i));
+      phases[num_phases].value = phase_micros_[i];
+      num_phases++;
+    }
+  }
+
+  Dart_GCMetric counters[kNumCounters];
+  intptr_t num_counters = 0;
+  for (intptr_t i = 0; i < kNumCounters; i++) {
+    if (counters_[i] != 0) {
+      counters[num_counters].name = CounterToString(static_cast<Counter>(i));
+      counters[num_counters].value = counters_[i];
+      num_counters++;
+    }
+  }
+
+  MallocGrowableArray<Dart_GCTask> tasks;
+  {
+    MutexLocker ml(&tasks_mutex_);
+    if (is_old_space) {
+      tasks.AddArray(concurrent_tasks_);
+      concurrent_tasks_.Clear();
+    }
+    tasks.AddArray(tasks_);
+  }
+
+  Dart_GCEvent event;
+  event.isolate_name = isolate_name;
+  event.type = type;
+  event.reason = reason;
+  event.start_micros = start_micros;
+  event.end_micros = end_micros;
+  event.num_phases = num_phases;
+  event.phases = phases;
+  event.num_counters = num_counters;
+  event.counters = counters;
+  event.num_tasks = tasks.length();
+  event.tasks = tasks.length() > 0 ? &tasks[0] : NULL;
+  callback(&event);
+}
+
+}  // namespace dart
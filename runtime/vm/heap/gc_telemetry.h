@@ -0,0 +1,119 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_HEAP_GC_TELEMETRY_H_
+#define RUNTIME_VM_HEAP_GC_TELEMETRY_H_
+
+#include "include/dart_tools_api.h"
+#include "platform/atomic.h"
+#include "vm/allocation.h"
+#include "vm/globals.h"
+#include "vm/growable_array.h"
+#include "vm/os_thread.h"
+
+namespace dart {
+
+// Phases of scavenges, mark-sweeps and mark-compacts. Phases may nest.
+#define GC_PHASE_LIST(V)                                                       \
+  V(SafePoint)                                                                 \
+  V(Roots)                                                                     \
+  V(StoreBuffer)                                                               \
+  V(FilterCards)                                                               \
+  V(ProcessToSpace)                                                            \
+  V(WeakHandles)                                                               \
+  V(WeakProperties)                                                            \
+  V(WeakTables)                                                                \
+  V(WaitForSweepers)                                                           \
+  V(Marking)                                                                   \
+  V(ResetFreeLists)                                                            \
+  V(Sweep)                                                                     \
+  V(SweepLarge)                                                                \
+  V(CompactPlan)                                                               \
+  V(CompactSlide)                                                              \
+  V(CompactForwardStack)
+
+#define GC_COUNTER_LIST(V)                                                     \
+  V(BytesCopied)                                                               \
+  V(BytesPromoted)                                                             \
+  V(ObjectsPromoted)                                                           \
+  V(StoreBufferEntries)                                                        \
+  V(CardsScanned)                                                              \
+  V(BytesMarked)
+
+// Collects per-phase timings, work counters and per-task records of the
+// collection in progress and hands them to the embedder's
+// Dart_GCEventCallback when the collection ends.
+class GCTelemetry {
+ public:
+  enum Phase {
+#define DECLARE_PHASE(name) k##name,
+    GC_PHASE_LIST(DECLARE_PHASE)
+#undef DECLARE_PHASE
+        kNumPhases
+  };
+
+  enum Counter {
+#define DECLARE_COUNTER(name) k##name,
+    GC_COUNTER_LIST(DECLARE_COUNTER)
+#undef DECLARE_COUNTER
+        kNumCounters
+  };
+
+  GCTelemetry();
+  ~GCTelemetry() {}
+
+  // Called when a collection starts.
+  void Reset();
+
+  // May be called concurrently by helper tasks.
+  void AddPhaseTime(Phase phase, int64_t micros) {
+    AtomicOperations::IncrementInt64By(&phase_micros_[phase], micros);
+  }
+  void AddCount(Counter counter, int64_t value) {
+    AtomicOperations::IncrementInt64By(&counters_[counter], value);
+  }
+  void AddTask(const char* name, int64_t micros, int64_t bytes);
+
+  // Concurrent marking tasks finish between collections. Their records are
+  // kept until the next mark-sweep or mark-compact reports them.
+  void AddConcurrentTask(const char* name, int64_t micros, int64_t bytes);
+
+  // Delivers the collection to the registered callback, if any.
+  void Report(const char* isolate_name,
+              const char* type,
+              const char* reason,
+              int64_t start_micros,
+              int64_t end_micros,
+              bool is_old_space);
+
+  // The callback may be replaced by the embedder while helper threads report
+  // collections.
+  static void set_callback(Dart_GCEventCallback callback) {
+    AtomicOperations::StoreRelease(&callback_, callback);
+  }
+  static Dart_GCEventCallback callback() {
+    return AtomicOperations::LoadAcquire(&callback_);
+  }
+
+  static const char* PhaseToString(Phase phase);
+  static const char* CounterToString(Counter counter);
+
+ private:
+  static Dart_GCTask MakeTask(const char* name, int64_t micros, int64_t bytes);
+
+  int64_t phase_micros_[kNumPhases];
+  int64_t counters_[kNumCounters];
+
+  Mutex tasks_mutex_;
+  MallocGrowableArray<Dart_GCTask> tasks_;
+  MallocGrowableArray<Dart_GCTask> concurrent_tasks_;
+
+  static Dart_GCEventCallback callback_;
+
+  DISALLOW_COPY_AND_ASSIGN(GCTelemetry);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_HEAP_GC_TELEMETRY_H_
@@ -437,6 +437,13 @@ void Heap::NotifyLowMemory() {
   CollectAllGarbage(kLowMemory);
 }
 
+void Heap::SetGoals(int64_t max_pause_micros,
+                    intptr_t heap_limit_in_words,
+                    int gc_time_ratio) {
+  new_space_.set_max_pause_micros(max_pause_micros);
+  old_space_.SetGoals(max_pause_micros, heap_limit_in_words, gc_time_ratio);
+}
+
 void Heap::EvacuateNewSpace(Thread* thread, GCReason reason) {
   ASSERT((reason != kOldSpace) && (reason != kPromotion));
   if (BeginNewSpaceGC(thread)) {
@@ -481,7 +488,7 @@ void Heap::CollectOldSpaceGarbage(Thread* thread,
                                   GCReason reason) {
   ASSERT(reason != kNewSpace);
   ASSERT(type != kScavenge);
-  if (FLAG_use_compactor) {
+  if (FLAG_use_compactor || old_space_.ShouldCompact()) {
     type = kMarkCompact;
   }
   if (BeginOldSpaceGC(thread)) {
@@ -887,6 +894,7 @@ void Heap::RecordBeforeGC(GCType type, GCReason reason) {
     stats_.times_[i] = 0;
   for (int i = 0; i < GCStats::kDataEntries; i++)
     stats_.data_[i] = 0;
+  telemetry_.Reset();
 }
 
 void Heap::RecordAfterGC(GCType type) {
@@ -904,6 +912,9 @@ void Heap::RecordAfterGC(GCType type) {
   ASSERT((type == kScavenge && gc_new_space_in_progress_) ||
          (type == kMarkSweep && gc_old_space_in_progress_) ||
          (type == kMarkCompact && gc_old_space_in_progress_));
+  telemetry_.Report(isolate()->name(), GCTypeToString(type),
+                    GCReasonToString(stats_.reason_), stats_.before_.micros_,
+                    stats_.after_.micros_, type != kScavenge);
 #ifndef PRODUCT
   if (FLAG_support_service && Service::gc_stream.enabled() &&
       !Isolate::IsVMInternalIsolate(isolate())) {
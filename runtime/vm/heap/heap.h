@@ -13,6 +13,7 @@
 #include "vm/allocation.h"
 #include "vm/flags.h"
 #include "vm/globals.h"
+#include "vm/heap/gc_telemetry.h"
 #include "vm/heap/pages.h"
 #include "vm/heap/scavenger.h"
 #include "vm/heap/spaces.h"
@@ -72,6 +73,8 @@ class Heap {
   Scavenger* new_space() { return &new_space_; }
   PageSpace* old_space() { return &old_space_; }
 
+  static intptr_t new_space_offset() { return OFFSET_OF(Heap, new_space_); }
+
   uword Allocate(intptr_t size, Space space) {
     ASSERT(!read_only_);
     switch (space) {
@@ -120,6 +123,12 @@ class Heap {
   void NotifyIdle(int64_t deadline);
   void NotifyLowMemory();
 
+  // Drives heap sizing by a maximum pause, a limit on the combined size of
+  // both generations and a GC time budget in percent. Zero disables a goal.
+  void SetGoals(int64_t max_pause_micros,
+                intptr_t heap_limit_in_words,
+                int gc_time_ratio);
+
   // Collect a single generation.
   void CollectGarbage(Space space);
   void CollectGarbage(GCType type, GCReason reason);
@@ -263,6 +272,8 @@ class Heap {
     stats_.data_[id] = value;
   }
 
+  GCTelemetry* telemetry() { return &telemetry_; }
+
   void UpdateGlobalMaxUsed();
 
   static bool IsAllocatableInNewSpace(intptr_t size) {
@@ -387,6 +398,7 @@ class Heap {
 
   // GC stats collection.
   GCStats stats_;
+  GCTelemetry telemetry_;
 
   // This heap is in read-only mode: No allocation is allowed.
   bool read_only_;
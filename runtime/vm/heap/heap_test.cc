@@ -14,6 +14,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, pretenure_threshold);
+
 TEST_CASE(OldGC) {
   const char* kScriptChars =
       "main() {\n"
@@ -785,4 +787,159 @@ ISOLATE_UNIT_TEST_CASE(ArrayTruncationRaces) {
   }
 }
 
+ISOLATE_UNIT_TEST_CASE(ScavengeFilteredRememberedCards) {
+  // Large enough for the scavenger to filter the cards with helper tasks.
+  const intptr_t kLength = 3 * MB;
+  const intptr_t kStride = 12345;  // Not aligned to cards.
+  const Array& array = Array::Handle(Array::New(kLength, Heap::kOld));
+  Double& element = Double::Handle();
+  for (intptr_t i = 0; i < kLength; i += kStride) {
+    element = Double::New(static_cast<double>(i), Heap::kNew);
+    array.SetAt(i, element);
+  }
+  for (intptr_t gc = 0; gc < 3; gc++) {
+    thread->heap()->CollectGarbage(Heap::kNew);
+    for (intptr_t i = 0; i < kLength; i++) {
+      if ((i % kStride) == 0) {
+        element ^= array.At(i);
+        EXPECT_EQ(static_cast<double>(i), element.value());
+      } else {
+        EXPECT(array.At(i) == Object::null());
+      }
+    }
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(ScavengeAdjacentFilteredRememberedCards) {
+  // Large enough for the scavenger to filter the cards with helper tasks.
+  const intptr_t kLength = 3 * MB;
+  const intptr_t kSlotsPerCard = 1 << HeapPage::kSlotsPerCardLog2;
+  const Array& array = Array::Handle(Array::New(kLength, Heap::kOld));
+  const intptr_t first_slot =
+      (reinterpret_cast<uword>(Array::DataOf(array.raw())) -
+       reinterpret_cast<uword>(HeapPage::Of(array.raw()))) /
+      kWordSize;
+
+  // Both cards are filtered to start at their first new-space slot, and the
+  // slot in the second card is less than a card past the slot in the first.
+  // It must still be visited once only, or its target is copied twice.
+  const intptr_t kCard = 1000;
+  const intptr_t index1 = kCard * kSlotsPerCard + 100 - first_slot;
+  const intptr_t index2 = (kCard + 1) * kSlotsPerCard + 50 - first_slot;
+  const intptr_t index3 = (kCard + 2) * kSlotsPerCard + 10 - first_slot;
+  Double& element = Double::Handle(Double::New(1.0, Heap::kNew));
+  array.SetAt(index1, element);
+  element = Double::New(2.0, Heap::kNew);
+  array.SetAt(index2, element);
+  array.SetAt(index3, element);
+
+  for (intptr_t gc = 0; gc < 3; gc++) {
+    thread->heap()->CollectGarbage(Heap::kNew);
+    element ^= array.At(index1);
+    EXPECT_EQ(1.0, element.value());
+    element ^= array.At(index2);
+    EXPECT_EQ(2.0, element.value());
+    EXPECT(array.At(index2) == array.At(index3));
+  }
+}
+
+
+#if !defined(TARGET_ARCH_DBC)
+TEST_CASE(Pretenuring) {
+  const char* kScriptChars =
+      "class Entry {\n"
+      "  var key;\n"
+      "}\n"
+      "class Temp {\n"
+      "  var key;\n"
+      "}\n"
+      "final cache = <Entry>[];\n"
+      "fill() {\n"
+      "  for (var i = 0; i < 5000; i++) {\n"
+      "    cache.add(new Entry());\n"
+      "    new Temp().key = i;\n"
+      "  }\n"
+      "}\n"
+      "allocate() => new Entry();\n";
+  const int saved_threshold = FLAG_pretenure_threshold;
+  FLAG_pretenure_threshold = 90;
+  Dart_Handle h_lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(h_lib);
+  EXPECT_VALID(Dart_Invoke(h_lib, NewString("fill"), 0, NULL));
+  {
+    TransitionNativeToVM transition(thread);
+    thread->heap()->CollectGarbage(Heap::kNew);
+
+    const Library& lib = Library::Handle(Library::RawCast(
+        Api::UnwrapHandle(h_lib)));
+    const Class& entry = Class::Handle(
+        lib.LookupClass(String::Handle(Symbols::New(thread, "Entry"))));
+    const Class& temp = Class::Handle(
+        lib.LookupClass(String::Handle(Symbols::New(thread, "Temp"))));
+    Scavenger* new_space = thread->heap()->new_space();
+    EXPECT(new_space->IsPretenured(entry.id()));
+    EXPECT(!new_space->IsPretenured(temp.id()));
+  }
+  Dart_Handle result = Dart_Invoke(h_lib, NewString("allocate"), 0, NULL);
+  EXPECT_VALID(result);
+  {
+    TransitionNativeToVM transition(thread);
+    EXPECT(Api::UnwrapHandle(result)->IsOldObject());
+  }
+  FLAG_pretenure_threshold = saved_threshold;
+}
+
+TEST_CASE(PretenuringDecay) {
+  const char* kScriptChars =
+      "class Entry {\n"
+      "  var key;\n"
+      "}\n"
+      "final cache = <Entry>[];\n"
+      "fill() {\n"
+      "  for (var i = 0; i < 5000; i++) {\n"
+      "    cache.add(new Entry());\n"
+      "  }\n"
+      "}\n"
+      "churn() {\n"
+      "  cache.clear();\n"
+      "  for (var i = 0; i < 5000; i++) {\n"
+      "    new Entry().key = i;\n"
+      "  }\n"
+      "}\n";
+  SetFlagScope<int> sfs(&FLAG_pretenure_threshold, 90);
+  Dart_Handle h_lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT_VALID(h_lib);
+  EXPECT_VALID(Dart_Invoke(h_lib, NewString("fill"), 0, NULL));
+  intptr_t cid;
+  {
+    TransitionNativeToVM transition(thread);
+    Heap* heap = thread->heap();
+    heap->CollectGarbage(Heap::kNew);
+    const Library& lib =
+        Library::Handle(Library::RawCast(Api::UnwrapHandle(h_lib)));
+    const Class& entry = Class::Handle(
+        lib.LookupClass(String::Handle(Symbols::New(thread, "Entry"))));
+    cid = entry.id();
+    EXPECT(heap->new_space()->IsPretenured(cid));
+
+    // Entry is sampled again after a while.
+    for (intptr_t i = 0; i < 1000 && heap->new_space()->IsPretenured(cid);
+         i++) {
+      heap->CollectGarbage(Heap::kNew);
+    }
+    EXPECT(!heap->new_space()->IsPretenured(cid));
+  }
+  // Now that its instances die young, it stays in new space.
+  EXPECT_VALID(Dart_Invoke(h_lib, NewString("churn"), 0, NULL));
+  {
+    TransitionNativeToVM transition(thread);
+    Heap* heap = thread->heap();
+    for (intptr_t i = 0; i < 300; i++) {
+      heap->CollectGarbage(Heap::kNew);
+      EXPECT(!heap->new_space()->IsPretenured(cid));
+    }
+  }
+}
+#endif  // !defined(TARGET_ARCH_DBC)
+
 }  // namespace dart
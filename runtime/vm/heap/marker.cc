@@ -579,23 +579,51 @@ void GCMarker::IterateRoots(ObjectPointerVisitor* visitor) {
 void GCMarker::IterateWeakRoots(HandleVisitor* visitor) {
   ApiState* state = isolate_->api_state();
   ASSERT(state != NULL);
+  const int64_t start = OS::GetCurrentMonotonicMicros();
   isolate_->VisitWeakPersistentHandles(visitor);
+  heap_->telemetry()->AddPhaseTime(GCTelemetry::kWeakHandles,
+                                   OS::GetCurrentMonotonicMicros() - start);
 }
 
-void GCMarker::ProcessWeakTables(PageSpace* page_space) {
-  for (int sel = 0; sel < Heap::kNumWeakSelectors; sel++) {
-    WeakTable* table =
-        heap_->GetWeakTable(Heap::kOld, static_cast<Heap::WeakSelector>(sel));
-    intptr_t size = table->size();
-    for (intptr_t i = 0; i < size; i++) {
+// Number of weak table entries swept by a marker task at a time.
+static const intptr_t kWeakTableChunkSize = 4 * KB;
+
+void GCMarker::ProcessWeakTables() {
+  for (;;) {
+    intptr_t start = kWeakTableChunkSize *
+                     AtomicOperations::FetchAndIncrement(
+                         &weak_table_chunks_started_);
+    WeakTable* table = NULL;
+    for (int sel = 0; sel < Heap::kNumWeakSelectors; sel++) {
+      WeakTable* candidate = heap_->GetWeakTable(
+          Heap::kOld, static_cast<Heap::WeakSelector>(sel));
+      if (start < candidate->size()) {
+        table = candidate;
+        break;
+      }
+      start -= Utils::RoundUp(candidate->size(), kWeakTableChunkSize);
+    }
+    if (table == NULL) {
+      return;  // No more chunks.
+    }
+
+    const intptr_t end =
+        Utils::Minimum(start + kWeakTableChunkSize, table->size());
+    intptr_t invalidated = 0;
+    for (intptr_t i = start; i < end; i++) {
       if (table->IsValidEntryAt(i)) {
         RawObject* raw_obj = table->ObjectAt(i);
         ASSERT(raw_obj->IsHeapObject());
         if (!raw_obj->IsMarked()) {
-          table->InvalidateAt(i);
+          table->InvalidateAtConcurrent(i);
+          invalidated++;
         }
       }
     }
+    // Other tasks may be sweeping other chunks of the same table.
+    if (invalidated > 0) {
+      table->DecrementCountBy(invalidated);
+    }
   }
 }
 
@@ -650,6 +678,8 @@ class ParallelMarkTask : public ThreadPool::Task {
     {
       TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ParallelMark");
       int64_t start = OS::GetCurrentMonotonicMicros();
+      // The visitor may carry over work from concurrent marking.
+      const uintptr_t marked_bytes_before = visitor_->marked_bytes();
 
       // Phase 1: Iterate over roots and drain marking stack in tasks.
       marker_->IterateRoots(visitor_);
@@ -712,13 +742,21 @@ class ParallelMarkTask : public ThreadPool::Task {
       // Phase 2: Weak processing and follow-up marking on main thread.
       barrier_->Sync();
 
-      // Phase 3: Finalize results from all markers (detach code, etc.).
+      // Phase 3: Marking is complete, so the weak tables can be swept in
+      // parallel with the other markers and the main thread.
+      marker_->ProcessWeakTables();
+      barrier_->Sync();
+
+      // Phase 4: Finalize results from all markers (detach code, etc.).
       int64_t stop = OS::GetCurrentMonotonicMicros();
       visitor_->AddMicros(stop - start);
       if (FLAG_log_marker_tasks) {
         THR_Print("Task marked %" Pd " bytes in %" Pd64 " micros.\n",
                   visitor_->marked_bytes(), visitor_->marked_micros());
       }
+      isolate_->heap()->telemetry()->AddTask(
+          "ParallelMark", stop - start,
+          visitor_->marked_bytes() - marked_bytes_before);
       marker_->FinalizeResultsFrom(visitor_);
 
       delete visitor_;
@@ -773,6 +811,8 @@ class ConcurrentMarkTask : public ThreadPool::Task {
         THR_Print("Task marked %" Pd " bytes in %" Pd64 " micros.\n",
                   visitor_->marked_bytes(), visitor_->marked_micros());
       }
+      isolate_->heap()->telemetry()->AddConcurrentTask(
+          "ConcurrentMark", stop - start, visitor_->marked_bytes());
     }
 
     isolate_->ScheduleInterrupts(Thread::kVMInterrupt);
@@ -845,6 +885,7 @@ GCMarker::GCMarker(Isolate* isolate, Heap* heap)
       heap_(heap),
       marking_stack_(),
       visitors_(),
+      weak_table_chunks_started_(0),
       marked_bytes_(0),
       marked_micros_(0) {
   visitors_ = new SyncMarkingVisitor*[FLAG_marker_tasks];
@@ -932,14 +973,22 @@ void GCMarker::MarkObjects(PageSpace* page_space, bool collect_code) {
         MarkingWeakVisitor mark_weak(thread);
         IterateWeakRoots(&mark_weak);
       }
+      const int64_t weak_tables = OS::GetCurrentMonotonicMicros();
+      weak_table_chunks_started_ = 0;
+      ProcessWeakTables();
+      heap_->telemetry()->AddPhaseTime(
+          GCTelemetry::kWeakTables,
+          OS::GetCurrentMonotonicMicros() - weak_tables);
       // All marking done; detach code, etc.
       int64_t stop = OS::GetCurrentMonotonicMicros();
       mark.AddMicros(stop - start);
+      heap_->telemetry()->AddTask("Mark", stop - start, mark.marked_bytes());
       FinalizeResultsFrom(&mark);
     } else {
       ThreadBarrier barrier(num_tasks + 1, heap_->barrier(),
                             heap_->barrier_done());
       ResetRootSlices();
+      weak_table_chunks_started_ = 0;
       // Used to coordinate draining among tasks; all start out as 'busy'.
       uintptr_t num_busy = num_tasks;
       // Phase 1: Iterate over roots and drain marking stack in tasks.
@@ -989,10 +1038,17 @@ void GCMarker::MarkObjects(PageSpace* page_space, bool collect_code) {
       }
       barrier.Sync();
 
-      // Phase 3: Finalize results from all markers (detach code, etc.).
+      // Phase 3: Sweep weak tables together with the markers.
+      const int64_t weak_tables = OS::GetCurrentMonotonicMicros();
+      ProcessWeakTables();
+      barrier.Sync();
+      heap_->telemetry()->AddPhaseTime(
+          GCTelemetry::kWeakTables,
+          OS::GetCurrentMonotonicMicros() - weak_tables);
+
+      // Phase 4: Finalize results from all markers (detach code, etc.).
       barrier.Exit();
     }
-    ProcessWeakTables(page_space);
     ProcessObjectIdTable();
   }
   Epilogue();
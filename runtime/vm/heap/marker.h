@@ -52,7 +52,9 @@ class GCMarker {
   void IterateWeakRoots(HandleVisitor* visitor);
   template <class MarkingVisitorType>
   void IterateWeakReferences(MarkingVisitorType* visitor);
-  void ProcessWeakTables(PageSpace* page_space);
+  // Invalidates the entries of unmarked objects in the old-space weak tables.
+  // The tables are split into chunks that marker tasks claim concurrently.
+  void ProcessWeakTables();
   void ProcessObjectIdTable();
 
   // Called by anyone: finalize and accumulate stats from 'visitor'.
@@ -69,6 +71,8 @@ class GCMarker {
   intptr_t root_slices_not_started_;
   intptr_t root_slices_not_finished_;
 
+  uintptr_t weak_table_chunks_started_;
+
   Mutex stats_mutex_;
   uintptr_t marked_bytes_;
   int64_t marked_micros_;
@@ -0,0 +1,192 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/heap/page_cache.h"
+
+#include "vm/dart.h"
+#include "vm/flags.h"
+#include "vm/growable_array.h"
+#include "vm/lockers.h"
+#include "vm/os.h"
+#include "vm/os_thread.h"
+#include "vm/thread_pool.h"
+#include "vm/virtual_memory.h"
+
+namespace dart {
+
+DEFINE_FLAG(int,
+            page_cache_size,
+            32,
+            "Maximum size in MB of freed old-space pages kept for reuse "
+            "(0 disables the cache).");
+
+// Cached pages that stay unused this long are decommitted.
+static const int64_t kDecommitDelayMicros = 500 * kMicrosecondsPerMillisecond;
+
+struct CachedPage {
+  enum State {
+    kCommitted,
+    kDecommitting,
+    kDecommitted,
+  };
+
+  VirtualMemory* memory;
+  int64_t released_micros;
+  State state;
+};
+
+static Monitor* page_cache_monitor = NULL;
+static MallocGrowableArray<CachedPage>* cached_pages = NULL;
+// Committed memory of the cached pages. Decommitted pages only retain
+// address space and are not counted.
+static intptr_t cached_bytes = 0;
+static bool decommit_task_running = false;
+static bool cache_enabled = false;
+
+class PageCacheDecommitTask : public ThreadPool::Task {
+ public:
+  PageCacheDecommitTask() {}
+
+  virtual void Run() { PageCache::DecommitIdlePages(); }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(PageCacheDecommitTask);
+};
+
+void PageCache::Init() {
+  if (page_cache_monitor == NULL) {
+    page_cache_monitor = new Monitor();
+    cached_pages = new MallocGrowableArray<CachedPage>();
+  }
+  MonitorLocker ml(page_cache_monitor);
+  cache_enabled = true;
+}
+
+void PageCache::Cleanup() {
+  if (page_cache_monitor == NULL) {
+    return;
+  }
+  MallocGrowableArray<CachedPage> pages;
+  {
+    MonitorLocker ml(page_cache_monitor);
+    cache_enabled = false;
+    ml.NotifyAll();
+    while (decommit_task_running) {
+      ml.Wait();
+    }
+    pages.AddArray(*cached_pages);
+    cached_pages->Clear();
+    cached_bytes = 0;
+  }
+  for (intptr_t i = 0; i < pages.length(); i++) {
+    delete pages[i].memory;
+  }
+}
+
+VirtualMemory* PageCache::TryAllocate(intptr_t size) {
+  if (page_cache_monitor == NULL) {
+    return NULL;
+  }
+  MonitorLocker ml(page_cache_monitor);
+  // The most recently released pages are the most likely to be committed.
+  for (intptr_t i = cached_pages->length() - 1; i >= 0; i--) {
+    const CachedPage& page = (*cached_pages)[i];
+    if ((page.state != CachedPage::kDecommitting) &&
+        (page.memory->size() == size)) {
+      VirtualMemory* memory = page.memory;
+      if (page.state == CachedPage::kCommitted) {
+        cached_bytes -= size;
+      }
+      cached_pages->RemoveAt(i);
+      return memory;
+    }
+  }
+  return NULL;
+}
+
+bool PageCache::TryRelease(VirtualMemory* memory) {
+  if (page_cache_monitor == NULL) {
+    return false;
+  }
+  const intptr_t size = memory->size();
+  MonitorLocker ml(page_cache_monitor);
+  if (!cache_enabled || (cached_bytes + size > FLAG_page_cache_size * MB)) {
+    return false;
+  }
+  CachedPage page;
+  page.memory = memory;
+  page.released_micros = OS::GetCurrentMonotonicMicros();
+  page.state = CachedPage::kCommitted;
+  cached_pages->Add(page);
+  cached_bytes += size;
+
+  if (memory->from_huge_page_pool()) {
+    // Stays committed until it is reused or the cache is cleaned up.
+    return true;
+  }
+  ThreadPool* pool = Dart::thread_pool();
+  if (!decommit_task_running && (pool != NULL)) {
+    PageCacheDecommitTask* task = new PageCacheDecommitTask();
+    decommit_task_running = pool->Run(task);
+    if (!decommit_task_running) {
+      delete task;
+    }
+  }
+  return true;
+}
+
+intptr_t PageCache::size_in_bytes() {
+  if (page_cache_monitor == NULL) {
+    return 0;
+  }
+  MonitorLocker ml(page_cache_monitor);
+  return cached_bytes;
+}
+
+void PageCache::DecommitIdlePages() {
+  MonitorLocker ml(page_cache_monitor);
+  while (cache_enabled) {
+    const int64_t now = OS::GetCurrentMonotonicMicros();
+    int64_t next_deadline = kMaxInt64;
+    VirtualMemory* idle = NULL;
+    for (intptr_t i = 0; i < cached_pages->length(); i++) {
+      CachedPage& page = (*cached_pages)[i];
+      if ((page.state != CachedPage::kCommitted) ||
+          page.memory->from_huge_page_pool()) {
+        continue;
+      }
+      const int64_t deadline = page.released_micros + kDecommitDelayMicros;
+      if (deadline <= now) {
+        // Allocation skips the page until it is decommitted.
+        page.state = CachedPage::kDecommitting;
+        idle = page.memory;
+        break;
+      }
+      next_deadline = Utils::Minimum(next_deadline, deadline);
+    }
+
+    if (idle != NULL) {
+      ml.Exit();
+      idle->Decommit();
+      ml.Enter();
+      for (intptr_t i = 0; i < cached_pages->length(); i++) {
+        if ((*cached_pages)[i].memory == idle) {
+          (*cached_pages)[i].state = CachedPage::kDecommitted;
+          cached_bytes -= idle->size();
+          break;
+        }
+      }
+      continue;
+    }
+
+    if (next_deadline == kMaxInt64) {
+      break;  // Everything is decommitted.
+    }
+    ml.WaitMicros(next_deadline - now);
+  }
+  decommit_task_running = false;
+  ml.NotifyAll();
+}
+
+}  // namespace dart
@@ -0,0 +1,48 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_HEAP_PAGE_CACHE_H_
+#define RUNTIME_VM_HEAP_PAGE_CACHE_H_
+
+#include "vm/allocation.h"
+#include "vm/globals.h"
+
+namespace dart {
+
+class VirtualMemory;
+
+// Keeps the memory of recently freed old-space data pages for reuse, which
+// avoids mapping and unmapping a region for every page when allocation
+// spikes alternate with collections. Pages that stay unused for a while are
+// decommitted by a background task but stay mapped, except for blocks of
+// huge-page segments, which decommitting would split. The committed memory
+// retained by the cache is bounded by --page_cache_size. Shared by all
+// isolates.
+class PageCache : public AllStatic {
+ public:
+  static void Init();
+
+  // Stops the decommit task and unmaps all cached pages. Pages released
+  // afterwards are unmapped immediately.
+  static void Cleanup();
+
+  // Returns a cached region of exactly 'size' bytes, or NULL. The contents of
+  // the region are unspecified.
+  static VirtualMemory* TryAllocate(intptr_t size);
+
+  // Takes ownership of 'memory' if it fits into the committed-memory budget.
+  // The memory must be writable.
+  static bool TryRelease(VirtualMemory* memory);
+
+  static intptr_t size_in_bytes();
+
+ private:
+  static void DecommitIdlePages();
+
+  friend class PageCacheDecommitTask;
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_HEAP_PAGE_CACHE_H_
@@ -9,6 +9,7 @@
 #include "vm/heap/become.h"
 #include "vm/heap/compactor.h"
 #include "vm/heap/marker.h"
+#include "vm/heap/page_cache.h"
 #include "vm/heap/safepoint.h"
 #include "vm/heap/sweeper.h"
 #include "vm/lockers.h"
@@ -57,8 +58,14 @@ DEFINE_FLAG(bool, log_growth, false, "Log PageSpace growth policy decisions.");
 HeapPage* HeapPage::Allocate(intptr_t size_in_words,
                              PageType type,
                              const char* name) {
-  VirtualMemory* memory = VirtualMemory::AllocateAligned(
-      size_in_words << kWordSizeLog2, kPageSize, type == kExecutable, name);
+  const intptr_t size = size_in_words << kWordSizeLog2;
+  // Code pages change protection, so only data pages are cached.
+  VirtualMemory* memory =
+      (type == kData) ? PageCache::TryAllocate(size) : NULL;
+  if (memory == NULL) {
+    memory = VirtualMemory::AllocateAligned(size, kPageSize,
+                                            type == kExecutable, name);
+  }
   if (memory == NULL) {
     return NULL;
   }
@@ -92,8 +99,11 @@ void HeapPage::Deallocate() {
   }
 
   // For a regular heap pages, the memory for this object will become
-  // unavailable after the delete below.
-  delete memory_;
+  // unavailable after it is deleted or cached below.
+  VirtualMemory* memory = memory_;
+  if (image_page || (type_ != kData) || !PageCache::TryRelease(memory)) {
+    delete memory;
+  }
 
   // For a heap page from a snapshot, the HeapPage object lives in the malloc
   // heap rather than the page itself.
@@ -128,15 +138,16 @@ void HeapPage::VisitObjectPointers(ObjectPointerVisitor* visitor) const {
   ASSERT(obj_addr == end_addr);
 }
 
-void HeapPage::VisitRememberedCards(ObjectPointerVisitor* visitor) {
+intptr_t HeapPage::VisitRememberedCards(ObjectPointerVisitor* visitor) {
   ASSERT(Thread::Current()->IsAtSafepoint());
   NoSafepointScope no_safepoint;
 
   if (card_table_ == NULL) {
-    return;
+    return 0;
   }
 
   bool table_is_empty = false;
+  intptr_t cards_visited = 0;
 
   RawArray* obj = static_cast<RawArray*>(RawObject::FromAddr(object_start()));
   ASSERT(obj->IsArray());
@@ -147,10 +158,11 @@ void HeapPage::VisitRememberedCards(ObjectPointerVisitor* visitor) {
   const intptr_t size = card_table_size();
   for (intptr_t i = 0; i < size; i++) {
     if (card_table_[i] != 0) {
-      RawObject** card_from =
+      cards_visited++;
+      RawObject** card_start =
           reinterpret_cast<RawObject**>(this) + (i << kSlotsPerCardLog2);
-      RawObject** card_to = reinterpret_cast<RawObject**>(card_from) +
-                            (1 << kSlotsPerCardLog2) - 1;
+      RawObject** card_from = card_start + card_table_[i] - 1;
+      RawObject** card_to = card_start + (1 << kSlotsPerCardLog2) - 1;
       // Minus 1 because to is inclusive.
 
       if (card_from < obj_from) {
@@ -186,6 +198,43 @@ void HeapPage::VisitRememberedCards(ObjectPointerVisitor* visitor) {
     free(card_table_);
     card_table_ = NULL;
   }
+  return cards_visited;
+}
+
+void HeapPage::FilterRememberedCards(intptr_t first_card, intptr_t last_card) {
+  ASSERT(card_table_ != NULL);
+  ASSERT((first_card >= 0) && (last_card <= card_table_size()));
+
+  RawArray* obj = static_cast<RawArray*>(RawObject::FromAddr(object_start()));
+  ASSERT(obj->IsArray());
+  ASSERT(obj->IsCardRemembered());
+  RawObject** obj_from = obj->from();
+  RawObject** obj_to = obj->to(Smi::Value(obj->ptr()->length_));
+
+  for (intptr_t i = first_card; i < last_card; i++) {
+    if (card_table_[i] == 0) {
+      continue;
+    }
+    RawObject** card_start =
+        reinterpret_cast<RawObject**>(this) + (i << kSlotsPerCardLog2);
+    RawObject** card_from = card_start + card_table_[i] - 1;
+    RawObject** card_to = card_start + (1 << kSlotsPerCardLog2) - 1;
+    if (card_from < obj_from) {
+      card_from = obj_from;
+    }
+    if (card_to > obj_to) {
+      card_to = obj_to;
+    }
+
+    uint8_t value = 0;
+    for (RawObject** slot = card_from; slot <= card_to; slot++) {
+      if ((*slot)->IsNewObjectMayBeSmi()) {
+        value = static_cast<uint8_t>(slot - card_start + 1);
+        break;
+      }
+    }
+    card_table_[i] = value;
+  }
 }
 
 RawObject* HeapPage::FindObject(FindObjectVisitor* visitor) const {
@@ -778,10 +827,50 @@ void PageSpace::VisitObjectPointers(ObjectPointerVisitor* visitor) const {
   }
 }
 
-void PageSpace::VisitRememberedCards(ObjectPointerVisitor* visitor) const {
+intptr_t PageSpace::VisitRememberedCards(
+    ObjectPointerVisitor* visitor) const {
+  intptr_t cards_visited = 0;
+  for (HeapPage* page = large_pages_; page != NULL; page = page->next()) {
+    cards_visited += page->VisitRememberedCards(visitor);
+  }
+  return cards_visited;
+}
+
+// Number of cards filtered by a scavenger task at a time.
+static const intptr_t kCardsPerFilterChunk = 1 * KB;
+
+void PageSpace::FilterRememberedCards(intptr_t* next_chunk) const {
+  for (;;) {
+    intptr_t first_card =
+        kCardsPerFilterChunk * AtomicOperations::FetchAndIncrement(next_chunk);
+    HeapPage* page = large_pages_;
+    for (; page != NULL; page = page->next()) {
+      if (page->card_table_ == NULL) {
+        continue;
+      }
+      const intptr_t size = page->card_table_size();
+      if (first_card < size) {
+        break;
+      }
+      first_card -= Utils::RoundUp(size, kCardsPerFilterChunk);
+    }
+    if (page == NULL) {
+      return;  // No more chunks.
+    }
+    page->FilterRememberedCards(
+        first_card, Utils::Minimum(first_card + kCardsPerFilterChunk,
+                                   page->card_table_size()));
+  }
+}
+
+intptr_t PageSpace::NumRememberedCards() const {
+  intptr_t num_cards = 0;
   for (HeapPage* page = large_pages_; page != NULL; page = page->next()) {
-    page->VisitRememberedCards(visitor);
+    if (page->card_table_ != NULL) {
+      num_cards += page->card_table_size();
+    }
   }
+  return num_cards;
 }
 
 RawObject* PageSpace::FindObject(FindObjectVisitor* visitor,
@@ -1126,6 +1215,8 @@ void PageSpace::CollectGarbageAtSafepoint(bool compact,
   usage_.used_in_words = marker_->marked_words() + allocated_black_in_words_;
   allocated_black_in_words_ = 0;
   mark_words_per_micro_ = marker_->MarkedWordsPerMicro();
+  heap_->telemetry()->AddCount(GCTelemetry::kBytesMarked,
+                               marker_->marked_words() * kWordSize);
   delete marker_;
   marker_ = NULL;
 
@@ -1215,6 +1306,18 @@ void PageSpace::CollectGarbageAtSafepoint(bool compact,
   heap_->RecordTime(kSweepPages, mid3 - mid2);
   heap_->RecordTime(kSweepLargePages, end - mid3);
 
+  GCTelemetry* telemetry = heap_->telemetry();
+  telemetry->AddPhaseTime(GCTelemetry::kWaitForSweepers,
+                          pre_safe_point - pre_wait_for_sweepers);
+  telemetry->AddPhaseTime(GCTelemetry::kSafePoint, start - pre_safe_point);
+  telemetry->AddPhaseTime(GCTelemetry::kMarking, mid1 - start);
+  telemetry->AddPhaseTime(GCTelemetry::kResetFreeLists, mid2 - mid1);
+  telemetry->AddPhaseTime(GCTelemetry::kSweepLarge, mid3 - mid2);
+  if (!compact) {
+    // The compactor reports its own phases.
+    telemetry->AddPhaseTime(GCTelemetry::kSweep, end - mid3);
+  }
+
   if (FLAG_print_free_list_after_gc) {
     OS::PrintErr("Data Freelist (after GC):\n");
     freelist_[HeapPage::kData].Print();
@@ -1365,6 +1468,9 @@ void PageSpace::SetupImagePage(void* pointer, uword size, bool is_executable) {
   image_pages_ = page;
 }
 
+// Never start concurrent marking before half of the allowed growth is used.
+static const intptr_t kMinMarkStartPercent = 50;
+
 PageSpaceController::PageSpaceController(Heap* heap,
                                          int heap_growth_ratio,
                                          int heap_growth_max,
@@ -1376,7 +1482,12 @@ PageSpaceController::PageSpaceController(Heap* heap,
       heap_growth_max_(heap_growth_max),
       garbage_collection_time_ratio_(garbage_collection_time_ratio),
       last_code_collection_in_us_(OS::GetCurrentMonotonicMicros()),
-      idle_gc_threshold_in_words_(0) {
+      idle_gc_threshold_in_words_(0),
+      max_pause_micros_(0),
+      heap_limit_in_words_(0),
+      gc_time_ratio_goal_(0),
+      last_pause_micros_(0),
+      mark_start_percent_(100) {
   intptr_t grow_heap = heap_growth_max / 2;
   gc_threshold_in_words_ =
       last_usage_.capacity_in_words + (kPageSizeInWords * grow_heap);
@@ -1406,7 +1517,51 @@ bool PageSpaceController::AlmostNeedsGarbageCollection(SpaceUsage after) const {
   if (heap_growth_ratio_ == 100) {
     return false;
   }
-  return after.CombinedCapacityInWords() > gc_threshold_in_words_;
+  return after.CombinedCapacityInWords() > MarkThresholdInWords();
+}
+
+intptr_t PageSpaceController::MarkThresholdInWords() const {
+  if (mark_start_percent_ >= 100) {
+    return gc_threshold_in_words_;
+  }
+  const intptr_t base = last_usage_.CombinedCapacityInWords();
+  if (gc_threshold_in_words_ <= base) {
+    return gc_threshold_in_words_;
+  }
+  return base + (gc_threshold_in_words_ - base) * mark_start_percent_ / 100;
+}
+
+void PageSpaceController::SetGoals(int64_t max_pause_micros,
+                                   intptr_t heap_limit_in_words,
+                                   int gc_time_ratio) {
+  max_pause_micros_ = max_pause_micros > 0 ? max_pause_micros : 0;
+  heap_limit_in_words_ = heap_limit_in_words > 0 ? heap_limit_in_words : 0;
+  gc_time_ratio_goal_ = Utils::Minimum(Utils::Maximum(gc_time_ratio, 0), 100);
+  if (max_pause_micros_ == 0) {
+    mark_start_percent_ = 100;
+  }
+}
+
+bool PageSpaceController::ShouldCompact() const {
+  if (heap_limit_in_words_ == 0) {
+    return false;
+  }
+  // Only worth it under memory pressure.
+  const intptr_t capacity = last_usage_.CombinedCapacityInWords() +
+                            heap_->new_space()->CapacityInWords();
+  if (capacity < (heap_limit_in_words_ / 4) * 3) {
+    return false;
+  }
+  // Only worth it if the last collection left at most half of the capacity in
+  // use, i.e. the free space is spread over partially filled pages.
+  if (last_usage_.used_in_words > last_usage_.capacity_in_words / 2) {
+    return false;
+  }
+  // Compaction roughly doubles the pause of a mark-sweep.
+  if ((max_pause_micros_ > 0) && (2 * last_pause_micros_ > max_pause_micros_)) {
+    return false;
+  }
+  return true;
 }
 
 bool PageSpaceController::NeedsIdleGarbageCollection(SpaceUsage current) const {
@@ -1427,6 +1582,23 @@ void PageSpaceController::EvaluateGarbageCollection(SpaceUsage before,
   history_.AddGarbageCollectionTime(start, end);
   const int gc_time_fraction = history_.GarbageCollectionTimeFraction();
   heap_->RecordData(PageSpace::kGCTimeFraction, gc_time_fraction);
+  const int gc_time_ratio = (gc_time_ratio_goal_ > 0)
+                                ? gc_time_ratio_goal_
+                                : garbage_collection_time_ratio_;
+
+  last_pause_micros_ = end - start;
+  if (max_pause_micros_ > 0) {
+    // A long finalization pause usually means concurrent marking did not get
+    // far enough before the threshold was hit, so start it earlier. Move back
+    // slowly once pauses are comfortably within the goal.
+    if (last_pause_micros_ > max_pause_micros_) {
+      mark_start_percent_ = Utils::Maximum(mark_start_percent_ - 10,
+                                           kMinMarkStartPercent);
+    } else if (2 * last_pause_micros_ < max_pause_micros_) {
+      mark_start_percent_ =
+          Utils::Minimum(mark_start_percent_ + 5, static_cast<intptr_t>(100));
+    }
+  }
 
   // Assume garbage increases linearly with allocation:
   // G = kA, and estimate k from the previous cycle.
@@ -1448,8 +1620,8 @@ void PageSpaceController::EvaluateGarbageCollection(SpaceUsage before,
     // Define GC to be 'worthwhile' iff at least fraction t of heap is garbage.
     double t = 1.0 - desired_utilization_;
     // If we spend too much time in GC, strive for even more free space.
-    if (gc_time_fraction > garbage_collection_time_ratio_) {
-      t += (gc_time_fraction - garbage_collection_time_ratio_) / 100.0;
+    if (gc_time_fraction > gc_time_ratio) {
+      t += (gc_time_fraction - gc_time_ratio) / 100.0;
     }
 
     // Number of pages we can allocate and still be within the desired growth
@@ -1511,6 +1683,16 @@ void PageSpaceController::EvaluateGarbageCollection(SpaceUsage before,
   gc_threshold_in_words_ =
       after.CombinedCapacityInWords() + (kPageSizeInWords * grow_heap);
 
+  // Keep the old generation and new generation together within the heap
+  // limit, but always allow a page of growth to avoid back-to-back GCs.
+  if (heap_limit_in_words_ > 0) {
+    const intptr_t old_limit =
+        heap_limit_in_words_ - heap_->new_space()->CapacityInWords();
+    gc_threshold_in_words_ = Utils::Maximum(
+        Utils::Minimum(gc_threshold_in_words_, old_limit),
+        after.CombinedCapacityInWords() + kPageSizeInWords);
+  }
+
   // Set a tight idle threshold.
   idle_gc_threshold_in_words_ =
       after.CombinedCapacityInWords() + 2 * kPageSizeInWords;
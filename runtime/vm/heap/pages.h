@@ -119,7 +119,8 @@ class HeapPage {
     return obj;
   }
 
-  // 1 card = 128 slots.
+  // 1 card = 128 slots. A non-zero card is remembered; its first
+  // (value - 1) slots are known to hold no pointers into new space.
   static const intptr_t kSlotsPerCardLog2 = 7;
   static const intptr_t kBytesPerCardLog2 = kWordSizeLog2 + kSlotsPerCardLog2;
 
@@ -143,7 +144,13 @@ class HeapPage {
     ASSERT((index >= 0) && (index < card_table_size()));
     card_table_[index] = 1;
   }
-  void VisitRememberedCards(ObjectPointerVisitor* visitor);
+  // Returns the number of remembered cards visited.
+  intptr_t VisitRememberedCards(ObjectPointerVisitor* visitor);
+
+  // Clears the cards in [first_card, last_card) that hold no pointers into
+  // new space and skips the others ahead to their first such pointer. Does
+  // not move objects, so disjoint ranges may be filtered concurrently.
+  void FilterRememberedCards(intptr_t first_card, intptr_t last_card);
 
  private:
   void set_object_end(uword value) {
@@ -238,7 +245,23 @@ class PageSpaceController {
   void Disable() { is_enabled_ = false; }
   bool is_enabled() { return is_enabled_; }
 
+  // Replaces the ratio based heuristics with explicit goals. A goal of zero
+  // is ignored. See Dart_SetHeapGoals.
+  void SetGoals(int64_t max_pause_micros,
+                intptr_t heap_limit_in_words,
+                int gc_time_ratio);
+  intptr_t heap_limit_in_words() const { return heap_limit_in_words_; }
+
+  // Whether the next finalizing collection should compact, which is the case
+  // when the heap is close to its limit, was fragmented after the previous
+  // collection, and the previous pause leaves room for compaction.
+  bool ShouldCompact() const;
+
  private:
+  // Start concurrent marking when capacity exceeds this amount. Equal to the
+  // GC threshold unless a pause goal moved it earlier.
+  intptr_t MarkThresholdInWords() const;
+
   Heap* heap_;
 
   bool is_enabled_;
@@ -274,6 +297,19 @@ class PageSpaceController {
   // Start considering idle GC when capacity exceeds this amount.
   intptr_t idle_gc_threshold_in_words_;
 
+  // Goals set through SetGoals, zero when not set.
+  int64_t max_pause_micros_;
+  intptr_t heap_limit_in_words_;
+  int gc_time_ratio_goal_;
+
+  // Duration of the last finalizing collection.
+  int64_t last_pause_micros_;
+
+  // Percentage of the growth allowed since the last collection after which
+  // concurrent marking starts. Lowered when pauses exceed max_pause_micros_
+  // so that marking has more time to finish concurrently.
+  intptr_t mark_start_percent_;
+
   PageSpaceGarbageCollectionHistory history_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(PageSpaceController);
@@ -306,6 +342,16 @@ class PageSpace {
   void EvaluateAfterLoading() {
     page_space_controller_.EvaluateAfterLoading(usage_);
   }
+  bool ShouldCompact() const { return page_space_controller_.ShouldCompact(); }
+  void SetGoals(int64_t max_pause_micros,
+                intptr_t heap_limit_in_words,
+                int gc_time_ratio) {
+    page_space_controller_.SetGoals(max_pause_micros, heap_limit_in_words,
+                                    gc_time_ratio);
+  }
+  intptr_t heap_limit_in_words() const {
+    return page_space_controller_.heap_limit_in_words();
+  }
 
   int64_t UsedInWords() const { return usage_.used_in_words; }
   int64_t CapacityInWords() const {
@@ -341,7 +387,13 @@ class PageSpace {
   void VisitObjectsImagePages(ObjectVisitor* visitor) const;
   void VisitObjectPointers(ObjectPointerVisitor* visitor) const;
 
-  void VisitRememberedCards(ObjectPointerVisitor* visitor) const;
+  intptr_t VisitRememberedCards(ObjectPointerVisitor* visitor) const;
+
+  // Filters the remembered cards of large pages in chunks claimed from
+  // '*next_chunk'. May be called by several tasks at once, but only before
+  // the scavenge starts moving objects.
+  void FilterRememberedCards(intptr_t* next_chunk) const;
+  intptr_t NumRememberedCards() const;
 
   RawObject* FindObject(FindObjectVisitor* visitor,
                         HeapPage::PageType type) const;
@@ -4,7 +4,9 @@
 
 #include "vm/heap/pages.h"
 #include "platform/assert.h"
+#include "vm/heap/page_cache.h"
 #include "vm/unit_test.h"
+#include "vm/virtual_memory.h"
 
 namespace dart {
 
@@ -31,4 +33,22 @@ TEST_CASE(Pages) {
   delete space;
 }
 
+VM_UNIT_TEST_CASE(PageCache) {
+  VirtualMemory* memory =
+      VirtualMemory::AllocateAligned(kPageSize, kPageSize, false, NULL);
+  EXPECT(memory != NULL);
+  const uword start = memory->start();
+  const intptr_t cached_before = PageCache::size_in_bytes();
+  EXPECT(PageCache::TryRelease(memory));
+  EXPECT_EQ(cached_before + kPageSize, PageCache::size_in_bytes());
+
+  // The most recently released page is reused first.
+  VirtualMemory* reused = PageCache::TryAllocate(kPageSize);
+  EXPECT(reused != NULL);
+  EXPECT_EQ(start, reused->start());
+  EXPECT_EQ(cached_before, PageCache::size_in_bytes());
+  memset(reused->address(), 0, kPageSize);
+  delete reused;
+}
+
 }  // namespace dart
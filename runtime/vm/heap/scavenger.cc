@@ -17,6 +17,7 @@
 #include "vm/object_id_ring.h"
 #include "vm/object_set.h"
 #include "vm/stack_frame.h"
+#include "vm/thread_pool.h"
 #include "vm/thread_registry.h"
 #include "vm/timeline.h"
 #include "vm/visitor.h"
@@ -33,6 +34,16 @@ DEFINE_FLAG(int,
             90,
             "Grow new gen when less than this percentage is garbage.");
 DEFINE_FLAG(int, new_gen_growth_factor, 2, "Grow new gen by this factor.");
+DEFINE_FLAG(int,
+            scavenger_card_tasks,
+            USING_MULTICORE ? 2 : 0,
+            "The number of tasks that filter remembered cards before a "
+            "scavenge visits them.");
+DEFINE_FLAG(int,
+            pretenure_threshold,
+            0,
+            "Allocate instances of a class directly in old space when more "
+            "than this percentage of them survive a scavenge (0 disables).");
 
 // Scavenger uses RawObject::kMarkBit to distinguish forwarded and non-forwarded
 // objects. The kMarkBit does not intersect with the target address because of
@@ -97,6 +108,7 @@ class ScavengerVisitor : public ObjectPointerVisitor {
         heap_(scavenger->heap_),
         page_space_(scavenger->heap_->old_space()),
         bytes_promoted_(0),
+        objects_promoted_(0),
         visiting_old_object_(NULL) {}
 
   void VisitPointers(RawObject** first, RawObject** last) {
@@ -122,6 +134,7 @@ class ScavengerVisitor : public ObjectPointerVisitor {
   }
 
   intptr_t bytes_promoted() const { return bytes_promoted_; }
+  intptr_t objects_promoted() const { return objects_promoted_; }
 
  private:
   void UpdateStoreBuffer(RawObject** p, RawObject* obj) {
@@ -178,6 +191,7 @@ class ScavengerVisitor : public ObjectPointerVisitor {
           // be traversed later.
           scavenger_->PushToPromotedStack(new_addr);
           bytes_promoted_ += size;
+          objects_promoted_++;
         } else {
           // Promotion did not succeed. Copy into the to space instead.
           scavenger_->failed_to_promote_ = true;
@@ -231,6 +245,7 @@ class ScavengerVisitor : public ObjectPointerVisitor {
   PageSpace* page_space_;
   RawWeakProperty* delayed_weak_properties_;
   intptr_t bytes_promoted_;
+  intptr_t objects_promoted_;
   RawObject* visiting_old_object_;
 
   friend class Scavenger;
@@ -401,11 +416,14 @@ Scavenger::Scavenger(Heap* heap,
       scavenge_words_per_micro_(kConservativeInitialScavengeSpeed),
       idle_scavenge_threshold_in_words_(0),
       external_size_(0),
-      failed_to_promote_(false) {
+      failed_to_promote_(false),
+      max_pause_micros_(0) {
   // Verify assumptions about the first word in objects which the scavenger is
   // going to use for forwarding pointers.
   ASSERT(Object::tags_offset() == 0);
 
+  memset(pretenured_cids_, 0, sizeof(pretenured_cids_));
+
   // Set initial semi space size in words.
   const intptr_t initial_semi_capacity_in_words = Utils::Minimum(
       max_semi_capacity_in_words, FLAG_new_gen_semi_initial_size * MBInWords);
@@ -438,6 +456,11 @@ intptr_t Scavenger::NewSizeInWords(intptr_t old_size_in_words) const {
   if (stats_history_.Size() == 0) {
     return old_size_in_words;
   }
+  if ((max_pause_micros_ > 0) &&
+      (2 * stats_history_.Get(0).DurationMicros() > max_pause_micros_)) {
+    // A larger new space would hold more survivors to copy per scavenge.
+    return old_size_in_words;
+  }
   double garbage = stats_history_.Get(0).ExpectedGarbageFraction();
   if (garbage < (FLAG_new_gen_garbage_threshold / 100.0)) {
     return Utils::Minimum(max_semi_capacity_in_words_,
@@ -601,9 +624,11 @@ void Scavenger::IterateStoreBuffers(Isolate* isolate,
   }
 
   visitor->VisitingOldObject(NULL);
-  heap_->old_space()->VisitRememberedCards(visitor);
+  intptr_t cards_scanned = heap_->old_space()->VisitRememberedCards(visitor);
 
   heap_->RecordData(kStoreBufferEntries, total_count);
+  heap_->telemetry()->AddCount(GCTelemetry::kStoreBufferEntries, total_count);
+  heap_->telemetry()->AddCount(GCTelemetry::kCardsScanned, cards_scanned);
   heap_->RecordData(kDataUnused1, 0);
   heap_->RecordData(kDataUnused2, 0);
   // Done iterating through old objects remembered in the store buffers.
@@ -620,6 +645,79 @@ void Scavenger::IterateObjectIdTable(Isolate* isolate,
 #endif  // !PRODUCT
 }
 
+class CardFilterTask : public ThreadPool::Task {
+ public:
+  CardFilterTask(PageSpace* old_space,
+                 intptr_t* next_chunk,
+                 Monitor* monitor,
+                 intptr_t* num_running)
+      : old_space_(old_space),
+        next_chunk_(next_chunk),
+        monitor_(monitor),
+        num_running_(num_running) {}
+
+  virtual void Run() {
+    old_space_->FilterRememberedCards(next_chunk_);
+    MonitorLocker ml(monitor_);
+    (*num_running_)--;
+    ml.NotifyAll();
+  }
+
+ private:
+  PageSpace* old_space_;
+  intptr_t* next_chunk_;
+  Monitor* monitor_;
+  intptr_t* num_running_;
+
+  DISALLOW_COPY_AND_ASSIGN(CardFilterTask);
+};
+
+// Below this many cards a single thread visits the card tables faster than
+// tasks can be started.
+static const intptr_t kMinCardsForFilterTasks = 16 * KB;
+
+void Scavenger::FilterRememberedCards() {
+  PageSpace* old_space = heap_->old_space();
+  const intptr_t num_tasks = FLAG_scavenger_card_tasks;
+  if ((num_tasks == 0) ||
+      (old_space->NumRememberedCards() < kMinCardsForFilterTasks)) {
+    return;
+  }
+
+  // Cards are only filtered before any object moves, so promotion cannot add
+  // large pages while the tasks walk the page list.
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  intptr_t next_chunk = 0;
+  // Only wait for the tasks that were started: chunks are claimed from
+  // next_chunk, so this thread filters whatever a missing task would have.
+  Monitor* monitor = heap_->barrier();
+  intptr_t num_running = 0;
+  for (intptr_t i = 0; i < num_tasks; i++) {
+    {
+      MonitorLocker ml(monitor);
+      num_running++;
+    }
+    CardFilterTask* task =
+        new CardFilterTask(old_space, &next_chunk, monitor, &num_running);
+    if (!Dart::thread_pool()->Run(task)) {
+      // The thread pool is shutting down.
+      delete task;
+      MonitorLocker ml(monitor);
+      num_running--;
+      break;
+    }
+  }
+  old_space->FilterRememberedCards(&next_chunk);
+  {
+    MonitorLocker ml(monitor);
+    while (num_running > 0) {
+      ml.Wait();
+    }
+  }
+  heap_->telemetry()->AddPhaseTime(GCTelemetry::kFilterCards,
+                                   OS::GetCurrentMonotonicMicros() - start);
+}
+
 void Scavenger::IterateRoots(Isolate* isolate, ScavengerVisitor* visitor) {
 #ifdef SUPPORT_TIMELINE
   Thread* thread = Thread::Current();
@@ -641,6 +739,8 @@ void Scavenger::IterateRoots(Isolate* isolate, ScavengerVisitor* visitor) {
   heap_->RecordTime(kVisitIsolateRoots, middle - start);
   heap_->RecordTime(kIterateStoreBuffers, end - middle);
   heap_->RecordTime(kDummyScavengeTime, 0);
+  heap_->telemetry()->AddPhaseTime(GCTelemetry::kRoots, middle - start);
+  heap_->telemetry()->AddPhaseTime(GCTelemetry::kStoreBuffer, end - middle);
 }
 
 bool Scavenger::IsUnreachable(RawObject** p) {
@@ -971,6 +1071,105 @@ uword Scavenger::TryAllocateNewTLAB(Thread* thread, intptr_t size) {
   return result;
 }
 
+// Minimum number of instances of a class that must be found in from-space
+// before its survival rate is considered meaningful.
+static const intptr_t kPretenureMinSampleCount = 1000;
+
+// Number of scavenges a class stays pretenured before it is sampled again.
+// The interval doubles every time a sample confirms the decision.
+static const intptr_t kPretenureInitialInterval = 8;
+static const intptr_t kPretenureMaxInterval = 128;
+
+void Scavenger::SetPretenured(intptr_t cid, bool value) {
+  uint8_t* bits = &pretenured_cids_[cid >> kBitsPerByteLog2];
+  if (value) {
+    *bits |= PretenuredCidMaskFor(cid);
+  } else {
+    *bits &= ~PretenuredCidMaskFor(cid);
+  }
+  if (FLAG_verbose_gc) {
+    const Class& cls = Class::Handle(heap_->isolate()->class_table()->At(cid));
+    OS::PrintErr("%s instances of %s\n",
+                 value ? "Pretenuring" : "Sampling survival of",
+                 cls.ToCString());
+  }
+}
+
+void Scavenger::DecayPretenuring() {
+  for (intptr_t i = 0; i < pretenured_classes_.length(); i++) {
+    PretenuredClass* entry = &pretenured_classes_[i];
+    if (entry->scavenges_left > 0) {
+      entry->scavenges_left--;
+      if (entry->scavenges_left == 0) {
+        SetPretenured(entry->cid, false);
+      }
+    }
+  }
+}
+
+void Scavenger::SamplePretenuring(Zone* zone,
+                                  SemiSpace* from,
+                                  uword from_top) {
+  ClassTable* class_table = heap_->isolate()->class_table();
+  const intptr_t num_cids = class_table->NumCids();
+  intptr_t* allocated = zone->Alloc<intptr_t>(num_cids);
+  intptr_t* survived = zone->Alloc<intptr_t>(num_cids);
+  memset(allocated, 0, num_cids * sizeof(intptr_t));
+  memset(survived, 0, num_cids * sizeof(intptr_t));
+
+  // The scavenge has completed, so every from-space object that is still
+  // reachable has been forwarded either to to-space or to old space. The
+  // original header of a forwarded object lives on in its copy.
+  uword cur = from->start() | object_alignment_;
+  while (cur < from_top) {
+    const uword header = *reinterpret_cast<uword*>(cur);
+    const bool is_forwarded = IsForwarding(header);
+    RawObject* raw_obj = RawObject::FromAddr(
+        is_forwarded ? ForwardedAddr(header) : cur);
+    const intptr_t cid = raw_obj->GetClassId();
+    if (cid < num_cids) {
+      allocated[cid]++;
+      if (is_forwarded) {
+        survived[cid]++;
+      }
+    }
+    cur += raw_obj->HeapSize();
+  }
+
+  // Only instances of user classes are allocated through the per-class
+  // allocation stubs and the AllocateObject runtime entry.
+  for (intptr_t cid = kNumPredefinedCids; cid < num_cids; cid++) {
+    if ((allocated[cid] < kPretenureMinSampleCount) || IsPretenured(cid) ||
+        !class_table->HasValidClassAt(cid)) {
+      continue;
+    }
+    intptr_t index = 0;
+    while ((index < pretenured_classes_.length()) &&
+           (pretenured_classes_[index].cid != cid)) {
+      index++;
+    }
+    if ((survived[cid] * 100) <
+        (allocated[cid] * FLAG_pretenure_threshold)) {
+      // Most instances die young again, so leave the class in new space.
+      if (index < pretenured_classes_.length()) {
+        pretenured_classes_.RemoveAt(index);
+      }
+      continue;
+    }
+    if (index < pretenured_classes_.length()) {
+      PretenuredClass* entry = &pretenured_classes_[index];
+      entry->interval =
+          Utils::Minimum(entry->interval * 2, kPretenureMaxInterval);
+      entry->scavenges_left = entry->interval;
+    } else {
+      PretenuredClass entry = {cid, kPretenureInitialInterval,
+                               kPretenureInitialInterval};
+      pretenured_classes_.Add(entry);
+    }
+    SetPretenured(cid, true);
+  }
+}
+
 void Scavenger::Scavenge() {
   Isolate* isolate = heap_->isolate();
   // Ensure that all threads for this isolate are at a safepoint (either stopped
@@ -995,6 +1194,7 @@ void Scavenger::Scavenge() {
 
   int64_t safe_point = OS::GetCurrentMonotonicMicros();
   heap_->RecordTime(kSafePoint, safe_point - start);
+  heap_->telemetry()->AddPhaseTime(GCTelemetry::kSafePoint, safe_point - start);
 
   // TODO(koda): Make verification more compatible with concurrent sweep.
   if (FLAG_verify_before_gc && !FLAG_concurrent_sweep) {
@@ -1007,6 +1207,7 @@ void Scavenger::Scavenge() {
   SpaceUsage usage_before = GetCurrentUsage();
   intptr_t promo_candidate_words =
       (survivor_end_ - FirstObjectStart()) / kWordSize;
+  const uword from_top = top_;
   SemiSpace* from = Prologue(isolate);
   // The API prologue/epilogue may create/destroy zones, so we must not
   // depend on zone allocations surviving beyond the epilogue callback.
@@ -1015,6 +1216,7 @@ void Scavenger::Scavenge() {
     // Setup the visitor and run the scavenge.
     ScavengerVisitor visitor(isolate, this, from);
     page_space->AcquireDataLock();
+    FilterRememberedCards();
     IterateRoots(isolate, &visitor);
     int64_t iterate_roots = OS::GetCurrentMonotonicMicros();
     {
@@ -1027,6 +1229,7 @@ void Scavenger::Scavenge() {
       ScavengerWeakVisitor weak_visitor(thread, this);
       IterateWeakRoots(isolate, &weak_visitor);
     }
+    int64_t weak_handles = OS::GetCurrentMonotonicMicros();
     ProcessWeakReferences();
     page_space->ReleaseDataLock();
 
@@ -1034,9 +1237,29 @@ void Scavenger::Scavenge() {
     int64_t end = OS::GetCurrentMonotonicMicros();
     heap_->RecordTime(kProcessToSpace, process_to_space - iterate_roots);
     heap_->RecordTime(kIterateWeaks, end - process_to_space);
+    GCTelemetry* telemetry = heap_->telemetry();
+    telemetry->AddPhaseTime(GCTelemetry::kProcessToSpace,
+                            process_to_space - iterate_roots);
+    telemetry->AddPhaseTime(GCTelemetry::kWeakHandles,
+                            weak_handles - process_to_space);
+    telemetry->AddPhaseTime(GCTelemetry::kWeakProperties, end - weak_handles);
+    telemetry->AddCount(GCTelemetry::kBytesCopied, UsedInWords() * kWordSize);
+    telemetry->AddCount(GCTelemetry::kBytesPromoted, visitor.bytes_promoted());
+    telemetry->AddCount(GCTelemetry::kObjectsPromoted,
+                        visitor.objects_promoted());
     stats_history_.Add(ScavengeStats(
         start, end, usage_before, GetCurrentUsage(), promo_candidate_words,
         visitor.bytes_promoted() >> kWordSizeLog2));
+
+#if !defined(DART_PRECOMPILED_RUNTIME) && !defined(TARGET_ARCH_DBC)
+    if (FLAG_pretenure_threshold > 0) {
+      TIMELINE_FUNCTION_GC_DURATION(thread, "Pretenuring");
+      DecayPretenuring();
+      SamplePretenuring(zone.GetZone(), from, from_top);
+    }
+#else
+    USE(from_top);
+#endif
   }
   Epilogue(isolate, from);
 
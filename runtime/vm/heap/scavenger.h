@@ -10,6 +10,7 @@
 #include "vm/dart.h"
 #include "vm/flags.h"
 #include "vm/globals.h"
+#include "vm/growable_array.h"
 #include "vm/heap/spaces.h"
 #include "vm/lockers.h"
 #include "vm/raw_object.h"
@@ -220,6 +221,27 @@ class Scavenger {
   int64_t FreeSpaceInWords(Isolate* isolate) const;
   void AbandonTLABs(Isolate* isolate);
 
+  // New space stops growing once scavenges take more than half of this time.
+  // Zero means no goal.
+  int64_t max_pause_micros() const { return max_pause_micros_; }
+  void set_max_pause_micros(int64_t value) { max_pause_micros_ = value; }
+
+  // Whether instances of the class with the given id are allocated directly
+  // in old space because most of them survived their first scavenge.
+  bool IsPretenured(intptr_t cid) const {
+    return (pretenured_cids_[cid >> kBitsPerByteLog2] &
+            PretenuredCidMaskFor(cid)) != 0;
+  }
+
+  // Allocation stubs test the bit of IsPretenured at run time, so that
+  // pretenuring a class or backing out of it needs no new stub.
+  static intptr_t PretenuredCidOffsetFor(intptr_t cid) {
+    return OFFSET_OF(Scavenger, pretenured_cids_) + (cid >> kBitsPerByteLog2);
+  }
+  static uint8_t PretenuredCidMaskFor(intptr_t cid) {
+    return 1 << (cid & (kBitsPerByte - 1));
+  }
+
  private:
   // Ids for time and data records in Heap::GCStats.
   enum {
@@ -242,6 +264,7 @@ class Scavenger {
   void IterateStoreBuffers(Isolate* isolate, ScavengerVisitor* visitor);
   void IterateObjectIdTable(Isolate* isolate, ScavengerVisitor* visitor);
   void IterateRoots(Isolate* isolate, ScavengerVisitor* visitor);
+  void FilterRememberedCards();
   void IterateWeakProperties(Isolate* isolate, ScavengerVisitor* visitor);
   void IterateWeakReferences(Isolate* isolate, ScavengerVisitor* visitor);
   void IterateWeakRoots(Isolate* isolate, HandleVisitor* visitor);
@@ -251,6 +274,15 @@ class Scavenger {
                             ScavengerVisitor* visitor);
   void Epilogue(Isolate* isolate, SemiSpace* from);
 
+  // Computes per-class survival rates from the forwarding state of the
+  // objects left in from-space and pretenures the classes whose instances
+  // mostly survive.
+  void SamplePretenuring(Zone* zone, SemiSpace* from, uword from_top);
+  // Stops pretenuring the classes whose probation is over, so that the next
+  // scavenges sample them again.
+  void DecayPretenuring();
+  void SetPretenured(intptr_t cid, bool value);
+
   bool IsUnreachable(RawObject** p);
 
   // During a scavenge we need to remember the promoted objects.
@@ -320,6 +352,22 @@ class Scavenger {
 
   bool failed_to_promote_;
 
+  int64_t max_pause_micros_;
+
+  // One bit per class id, see IsPretenured. Only updated at a safepoint.
+  uint8_t pretenured_cids_[(1 << RawObject::kClassIdTagSize) / kBitsPerByte];
+
+  struct PretenuredClass {
+    intptr_t cid;
+    // Scavenges until the class is sampled again, or 0 while it is sampled.
+    intptr_t scavenges_left;
+    // Scavenges between samples; doubles whenever the class is pretenured
+    // again.
+    intptr_t interval;
+  };
+  // Classes that are or were pretenured.
+  MallocGrowableArray<PretenuredClass> pretenured_classes_;
+
   // Protects new space during the allocation of new TLABs
   Mutex space_lock_;
 
@@ -8,6 +8,7 @@
 #include "vm/globals.h"
 
 #include "platform/assert.h"
+#include "platform/atomic.h"
 #include "vm/raw_object.h"
 
 namespace dart {
@@ -59,6 +60,20 @@ class WeakTable {
     SetValueAt(i, 0);
   }
 
+  // Like InvalidateAt, but leaves count() untouched so that disjoint ranges
+  // of entries can be invalidated by several threads at once. The caller
+  // accounts for the invalidated entries with DecrementCountBy.
+  void InvalidateAtConcurrent(intptr_t i) {
+    ASSERT(IsValidEntryAt(i));
+    data_[ObjectIndex(i)] = kDeletedEntry;
+    data_[ValueIndex(i)] = 0;
+  }
+
+  void DecrementCountBy(intptr_t n) {
+    ASSERT(n >= 0);
+    AtomicOperations::DecrementBy(&count_, n);
+  }
+
   RawObject* ObjectAt(intptr_t i) const {
     ASSERT(i >= 0);
     ASSERT(i < size());
@@ -82,6 +82,16 @@ class InterpreterSetjmpBuffer {
   DISALLOW_COPY_AND_ASSIGN(InterpreterSetjmpBuffer);
 };
 
+// Moving interpreted activations into OSR code needs the
+// InvokeDartOsrCodeFromBytecode stub, and the frame size that only JIT
+// configurations record in Code::variables().
+#if (defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)) &&                \
+    !defined(DART_PRECOMPILER)
+static const bool kCanTransferToOsrCode = true;
+#else
+static const bool kCanTransferToOsrCode = false;
+#endif
+
 DART_FORCE_INLINE static RawObject** SavedCallerFP(RawObject** FP) {
   return reinterpret_cast<RawObject**>(FP[kKBCSavedCallerFpSlotFromFp]);
 }
@@ -565,6 +575,129 @@ DART_NOINLINE bool Interpreter::InvokeCompiled(Thread* thread,
   return true;
 }
 
+// Moves the activation at *FP, stopped at a loop stack check with an empty
+// expression stack, into [code], which was compiled with an OSR entry at that
+// check, and runs it to completion. Sets *transferred to false if the frame
+// does not fit on the interpreter stack; otherwise, on success, *SP holds the
+// result to return to the caller of the activation.
+DART_NOINLINE bool Interpreter::InvokeOsr(bool* transferred,
+                                          Thread* thread,
+                                          RawCode* code,
+                                          RawObject*** FP,
+                                          RawObject*** SP) {
+  // Unoptimized code keeps fixed parameters in the caller's argument slots and
+  // copies optional ones into locals, the same way bytecode does.
+  RawFunction* function = FrameFunction(*FP);
+  const uint32_t packed_fields = function->ptr()->packed_fields_;
+  const intptr_t num_args =
+      (RawFunction::PackedNumOptionalParameters::decode(packed_fields) > 0)
+          ? 0
+          : RawFunction::PackedNumFixedParameters::decode(packed_fields);
+  // Locals the compiler adds after the bytecode frame are dead at loop stack
+  // checks and start out null.
+  const intptr_t num_frame_locals = (*SP + 1) - *FP;
+  const intptr_t num_locals =
+      Smi::Value(code->ptr()->catch_entry_.variables_) - num_args;
+  ASSERT(num_locals >= num_frame_locals);
+
+  // The stub pushes the frame contents: Smi argument count, arguments,
+  // Smi local count, locals.
+  RawObject** frame = *SP + 1;
+  RawObject** frame_end = frame + num_args + num_locals + 2;
+  if (reinterpret_cast<uword>(frame_end + kKBCDartFrameFixedSize) >=
+      stack_limit()) {
+    *transferred = false;
+    return true;
+  }
+  *transferred = true;
+  RawObject** args = FrameArguments(*FP, num_args);
+  frame[0] = Smi::New(num_args);
+  for (intptr_t i = 0; i < num_args; i++) {
+    frame[1 + i] = args[i];
+  }
+  RawObject** locals = frame + num_args + 2;
+  locals[-1] = Smi::New(num_locals);
+  RawObject* null_value = Object::null();
+  for (intptr_t i = 0; i < num_locals; i++) {
+    locals[i] = (i < num_frame_locals) ? (*FP)[i] : null_value;
+  }
+#if defined(DEBUG)
+  if (IsTracingExecution()) {
+    THR_Print("%" Pu64 " ", icount_);
+    THR_Print("invoking OSR code for %s\n",
+              Function::Handle(function).ToCString());
+  }
+#endif
+
+  // On success, returns a RawInstance.  On failure, a RawError.
+  typedef RawObject* (*invokestub)(RawCode * code, RawObject * *frame,
+                                   Thread * thread);
+  invokestub volatile entrypoint = reinterpret_cast<invokestub>(
+      StubCode::InvokeDartOsrCodeFromBytecode().EntryPoint());
+  RawObject* volatile result;
+  // The OSR code owns the state of the activation from now on, so stack
+  // walkers skip the interpreted frame: it would otherwise be visited twice,
+  // and its exception handlers searched at a stale pc.
+  Exit(thread, SavedCallerFP(*FP), frame_end, SavedCallerPC(*FP));
+  {
+    InterpreterSetjmpBuffer buffer(this);
+    if (!setjmp(buffer.buffer_)) {
+#if defined(TARGET_ARCH_DBC)
+      USE(entrypoint);
+      UNIMPLEMENTED();
+#elif defined(USING_SIMULATOR)
+      result = bit_copy<RawObject*, int64_t>(
+          Simulator::Current()->Call(reinterpret_cast<intptr_t>(entrypoint),
+                                     reinterpret_cast<intptr_t>(code),
+                                     reinterpret_cast<intptr_t>(frame),
+                                     reinterpret_cast<intptr_t>(thread), 0));
+#else
+      result = entrypoint(code, frame, thread);
+#endif
+      thread->set_top_exit_frame_info(0);
+      ASSERT(thread->vm_tag() == VMTag::kDartInterpretedTagId);
+      ASSERT(thread->execution_state() == Thread::kThreadInGenerated);
+    } else {
+      return false;
+    }
+  }
+  *SP = frame;
+  **SP = result;
+
+  // If the result is an error (not a Dart instance), it must either be rethrown
+  // (in the case of an unhandled exception) or it must be returned to the
+  // caller of the interpreter to be propagated.
+  if (result->IsHeapObject()) {
+    const intptr_t result_cid = result->GetClassId();
+    if (result_cid == kUnhandledExceptionCid) {
+      // Rethrow from the caller, as the activation has completed.
+      (*SP)[0] = UnhandledException::RawCast(result)->ptr()->exception_;
+      (*SP)[1] = UnhandledException::RawCast(result)->ptr()->stacktrace_;
+      (*SP)[2] = 0;  // Space for result.
+      Exit(thread, SavedCallerFP(*FP), *SP + 3, SavedCallerPC(*FP));
+      NativeArguments args(thread, 2, *SP, *SP + 2);
+      if (!InvokeRuntime(thread, this, DRT_ReThrow, args)) {
+        return false;
+      }
+      UNREACHABLE();
+    }
+    if (RawObject::IsErrorClassId(result_cid)) {
+      // Unwind to entry frame.
+      fp_ = *FP;
+      pc_ = reinterpret_cast<uword>(SavedCallerPC(fp_));
+      while (!IsEntryFrameMarker(pc_)) {
+        fp_ = SavedCallerFP(fp_);
+        pc_ = reinterpret_cast<uword>(SavedCallerPC(fp_));
+      }
+      // Pop entry frame.
+      fp_ = SavedCallerFP(fp_);
+      special_[KernelBytecode::kExceptionSpecialIndex] = result;
+      return false;
+    }
+  }
+  return true;
+}
+
 DART_NOINLINE bool Interpreter::ProcessInvocation(bool* invoked,
                                                   Thread* thread,
                                                   RawFunction* function,
@@ -969,6 +1102,15 @@ void Interpreter::InlineCacheMiss(int checked_args,
   argdesc_ = Array::RawCast(top[1]);
 }
 
+DART_FORCE_INLINE bool Interpreter::IsMegamorphic(RawICData* icdata) {
+  const intptr_t checked_args =
+      ICData::NumArgsTestedBits::decode(icdata->ptr()->state_bits_);
+  const intptr_t length = Smi::Value(icdata->ptr()->entries_->ptr()->length_);
+  // The entries end with a sentinel check.
+  const intptr_t num_checks = (length / (checked_args + 2)) - 1;
+  return num_checks > FLAG_max_polymorphic_checks;
+}
+
 DART_FORCE_INLINE bool Interpreter::InterfaceCall(Thread* thread,
                                                   RawString* target_name,
                                                   RawObject** call_base,
@@ -1291,6 +1433,28 @@ DART_FORCE_INLINE bool Interpreter::InstanceCall2(Thread* thread,
   }                                                                            \
   ASSERT(Integer::GetInt64Value(RAW_CAST(Integer, SP[0])) == result);
 
+// Stores the boolean 'condition' into SP[0] and dispatches. A JumpIfTrue or
+// JumpIfFalse which immediately follows and consumes the boolean is executed
+// right away instead, without materializing the boolean and without going
+// through the dispatch table.
+#define DISPATCH_CONDITION(condition)                                          \
+  do {                                                                         \
+    const bool result = (condition);                                           \
+    const KernelBytecode::Opcode next = KernelBytecode::DecodeOpcode(*pc);     \
+    if ((next == KernelBytecode::kJumpIfTrue) ||                               \
+        (next == KernelBytecode::kJumpIfFalse)) {                              \
+      op = *pc++;                                                              \
+      TRACE_INSTRUCTION                                                        \
+      SP -= 1;                                                                 \
+      if (result == (next == KernelBytecode::kJumpIfTrue)) {                   \
+        LOAD_JUMP_TARGET();                                                    \
+      }                                                                        \
+    } else {                                                                   \
+      SP[0] = result ? true_value : false_value;                               \
+    }                                                                          \
+    DISPATCH();                                                                \
+  } while (0)
+
 bool Interpreter::AssertAssignable(Thread* thread,
                                    uint32_t* pc,
                                    RawObject** FP,
@@ -1842,6 +2006,31 @@ SwitchDispatch:
       Exit(thread, FP, SP + 3, pc);
       NativeArguments native_args(thread, 1, SP + 2, SP + 1);
       INVOKE_RUNTIME(DRT_OptimizeInvokedFunction, native_args);
+    } else if (UNLIKELY(kCanTransferToOsrCode && (rA > 0) &&
+                        (FLAG_optimization_counter_threshold >= 0) &&
+                        (counter >=
+                         FLAG_optimization_counter_threshold * (rA + 1)) &&
+                        Function::HasCode(function) &&
+                        thread->isolate()->use_osr())) {
+      // Move a long running activation into optimized code at a loop stack
+      // check, using the thresholds unoptimized code uses for OSR.
+      uint32_t* instructions = reinterpret_cast<uint32_t*>(
+          InterpreterHelpers::FrameBytecode(FP)->ptr()->instructions_);
+      SP[1] = 0;  // Code result.
+      SP[2] = function;
+      SP[3] = Smi::New((pc - 1) - instructions);
+      Exit(thread, FP, SP + 4, pc);
+      NativeArguments native_args(thread, 2, SP + 2, SP + 1);
+      INVOKE_RUNTIME(DRT_CompileInterpretedFunctionForOsr, native_args);
+      if (SP[1] != null_value) {
+        bool transferred;
+        if (!InvokeOsr(&transferred, thread, Code::RawCast(SP[1]), &FP, &SP)) {
+          HANDLE_EXCEPTION;
+        }
+        if (transferred) {
+          goto ReturnFromOsr;
+        }
+      }
     }
     DISPATCH();
   }
@@ -2010,8 +2199,7 @@ SwitchDispatch:
 
   {
     BYTECODE(BooleanNegateTOS, 0);
-    SP[0] = (SP[0] == true_value) ? false_value : true_value;
-    DISPATCH();
+    DISPATCH_CONDITION(SP[0] != true_value);
   }
 
   {
@@ -2095,12 +2283,28 @@ SwitchDispatch:
       RawObject** call_base = SP - argc + 1;
       RawObject** call_top = SP + 1;
 
+      RawICData* icdata = RAW_CAST(ICData, LOAD_CONSTANT(kidx));
       InterpreterHelpers::IncrementUsageCounter(FrameFunction(FP));
-      RawString* target_name = static_cast<RawString*>(LOAD_CONSTANT(kidx));
-      argdesc_ = static_cast<RawArray*>(LOAD_CONSTANT(kidx + 1));
-      if (!InterfaceCall(thread, target_name, call_base, call_top, &pc, &FP,
-                         &SP)) {
-        HANDLE_EXCEPTION;
+      if (UNLIKELY(IsMegamorphic(icdata))) {
+        // Scanning the checks would be slower than the lookup cache.
+        argdesc_ = icdata->ptr()->args_descriptor_;
+        if (!InterfaceCall(thread, icdata->ptr()->target_name_, call_base,
+                           call_top, &pc, &FP, &SP)) {
+          HANDLE_EXCEPTION;
+        }
+      } else if (ICData::NumArgsTestedBits::decode(
+                     icdata->ptr()->state_bits_) == 1) {
+        if (!InstanceCall1(thread, icdata, call_base, call_top, &pc, &FP, &SP,
+                           false /* optimized */)) {
+          HANDLE_EXCEPTION;
+        }
+      } else {
+        ASSERT(ICData::NumArgsTestedBits::decode(icdata->ptr()->state_bits_) ==
+               2);
+        if (!InstanceCall2(thread, icdata, call_base, call_top, &pc, &FP, &SP,
+                           false /* optimized */)) {
+          HANDLE_EXCEPTION;
+        }
       }
     }
 
@@ -2327,6 +2531,7 @@ SwitchDispatch:
     RawObject* result;  // result to return to the caller.
 
     BYTECODE(ReturnTOS, 0);
+  ReturnFromOsr:
     result = *SP;
     // Restore caller PC.
     pc = SavedCallerPC(FP);
@@ -2767,8 +2972,7 @@ SwitchDispatch:
 
   {
     BYTECODE(EqualsNull, 0);
-    SP[0] = (SP[0] == null_value) ? true_value : false_value;
-    DISPATCH();
+    DISPATCH_CONDITION(SP[0] == null_value);
   }
 
   {
@@ -2914,16 +3118,15 @@ SwitchDispatch:
     BYTECODE(CompareIntEq, 0);
     SP -= 1;
     if (SP[0] == SP[1]) {
-      SP[0] = true_value;
+      DISPATCH_CONDITION(true);
     } else if (!SP[0]->IsHeapObject() || !SP[1]->IsHeapObject() ||
                (SP[0] == null_value) || (SP[1] == null_value)) {
-      SP[0] = false_value;
+      DISPATCH_CONDITION(false);
     } else {
       int64_t a = Integer::GetInt64Value(RAW_CAST(Integer, SP[0]));
       int64_t b = Integer::GetInt64Value(RAW_CAST(Integer, SP[1]));
-      SP[0] = (a == b) ? true_value : false_value;
+      DISPATCH_CONDITION(a == b);
     }
-    DISPATCH();
   }
 
   {
@@ -2931,8 +3134,7 @@ SwitchDispatch:
     SP -= 1;
     UNBOX_INT64(a, SP[0], Symbols::RAngleBracket());
     UNBOX_INT64(b, SP[1], Symbols::RAngleBracket());
-    SP[0] = (a > b) ? true_value : false_value;
-    DISPATCH();
+    DISPATCH_CONDITION(a > b);
   }
 
   {
@@ -2940,8 +3142,7 @@ SwitchDispatch:
     SP -= 1;
     UNBOX_INT64(a, SP[0], Symbols::LAngleBracket());
     UNBOX_INT64(b, SP[1], Symbols::LAngleBracket());
-    SP[0] = (a < b) ? true_value : false_value;
-    DISPATCH();
+    DISPATCH_CONDITION(a < b);
   }
 
   {
@@ -2949,8 +3150,7 @@ SwitchDispatch:
     SP -= 1;
     UNBOX_INT64(a, SP[0], Symbols::GreaterEqualOperator());
     UNBOX_INT64(b, SP[1], Symbols::GreaterEqualOperator());
-    SP[0] = (a >= b) ? true_value : false_value;
-    DISPATCH();
+    DISPATCH_CONDITION(a >= b);
   }
 
   {
@@ -2958,8 +3158,7 @@ SwitchDispatch:
     SP -= 1;
     UNBOX_INT64(a, SP[0], Symbols::LessEqualOperator());
     UNBOX_INT64(b, SP[1], Symbols::LessEqualOperator());
-    SP[0] = (a <= b) ? true_value : false_value;
-    DISPATCH();
+    DISPATCH_CONDITION(a <= b);
   }
 
   {
@@ -22,6 +22,7 @@ class Array;
 class RawICData;
 class RawImmutableArray;
 class RawArray;
+class RawCode;
 class RawObjectPool;
 class RawFunction;
 class RawString;
@@ -163,6 +164,12 @@ class Interpreter {
                       RawObject*** FP,
                       RawObject*** SP);
 
+  bool InvokeOsr(bool* transferred,
+                 Thread* thread,
+                 RawCode* code,
+                 RawObject*** FP,
+                 RawObject*** SP);
+
   void InlineCacheMiss(int checked_args,
                        Thread* thread,
                        RawICData* icdata,
@@ -172,6 +179,10 @@ class Interpreter {
                        RawObject** FP,
                        RawObject** SP);
 
+  // Returns true if the inline cache holds more checks than are worth
+  // scanning linearly on every call.
+  static bool IsMegamorphic(RawICData* icdata);
+
   bool InterfaceCall(Thread* thread,
                      RawString* target_name,
                      RawObject** call_base,
@@ -6,12 +6,15 @@
 
 #include <string.h>
 
+#include "platform/atomic.h"
 #include "vm/compiler/frontend/constant_evaluator.h"
 #include "vm/compiler/frontend/kernel_translation_helper.h"
+#include "vm/dart.h"
 #include "vm/dart_api_impl.h"
 #include "vm/flags.h"
 #include "vm/heap/heap.h"
 #include "vm/kernel_binary.h"
+#include "vm/lockers.h"
 #include "vm/longjump.h"
 #include "vm/object_store.h"
 #include "vm/parser.h"
@@ -19,6 +22,7 @@
 #include "vm/service_isolate.h"
 #include "vm/symbols.h"
 #include "vm/thread.h"
+#include "vm/thread_pool.h"
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
 namespace dart {
@@ -112,6 +116,217 @@ class SimpleExpressionConverter {
   DISALLOW_COPY_AND_ASSIGN(SimpleExpressionConverter);
 };
 
+// Decodes the line starts of the scripts in a program's source table.
+//
+// Only the line starts are decoded in parallel. The rest of the loading
+// (libraries, classes, fields and procedures) allocates and looks up heap
+// objects through the translation helper, so it stays on the mutator.
+//
+// Decoding only reads the immutable kernel binary. A first parallel pass
+// finds the number of entries and the largest entry of every script. The
+// mutator then allocates the line starts arrays, and a second parallel pass
+// decodes the entries straight into them. Old-space objects do not move
+// while the mutator waits for the tasks, because it does so without
+// entering a safepoint.
+class LineStartsDecoder : public ValueObject {
+ public:
+  // Don't bother with helper tasks for small programs.
+  static const intptr_t kMinScriptsPerTask = 64;
+
+  LineStartsDecoder(Zone* zone, Program* program)
+      : zone_(zone),
+        buffer_(program->kernel_data()),
+        size_(program->kernel_data_size()),
+        source_table_end_(program->name_table_offset()),
+        count_(0),
+        line_starts_(Array::Handle(zone)),
+        entries_(NULL),
+        pass_(kMeasure),
+        next_index_(0),
+        pending_tasks_(0) {
+    Reader reader(buffer_, size_);
+    reader.set_offset(program->source_table_offset());
+    count_ = reader.ReadUInt32();  // read source table size.
+  }
+
+  ~LineStartsDecoder() { delete[] entries_; }
+
+  // Decodes all line starts on up to FLAG_kernel_loader_tasks helper tasks
+  // and the current thread. Returns false if the program is too small to
+  // benefit, in which case nothing has been decoded.
+  bool Decode() {
+    const intptr_t num_tasks =
+        Utils::Minimum(static_cast<intptr_t>(FLAG_kernel_loader_tasks),
+                       count_ / kMinScriptsPerTask - 1);
+    if (num_tasks <= 0) {
+      return false;
+    }
+    entries_ = new Entry[count_];
+    RunPass(kMeasure, num_tasks);
+
+    line_starts_ = Array::New(count_, Heap::kOld);
+    TypedData& line_starts = TypedData::Handle(zone_);
+    for (intptr_t index = 0; index < count_; index++) {
+      line_starts = TypedData::New(CidFor(entries_[index].max_delta),
+                                   entries_[index].count, Heap::kOld);
+      line_starts_.SetAt(index, line_starts);
+    }
+
+    NoSafepointScope no_safepoint;
+    for (intptr_t index = 0; index < count_; index++) {
+      line_starts ^= line_starts_.At(index);
+      entries_[index].data = line_starts.DataAddr(0);
+      entries_[index].cid = line_starts.GetClassId();
+    }
+    RunPass(kFill, num_tasks);
+    return true;
+  }
+
+  RawTypedData* LineStartsAt(intptr_t index) const {
+    ASSERT(!line_starts_.IsNull());
+    ASSERT((index >= 0) && (index < count_));
+    return TypedData::RawCast(line_starts_.At(index));
+  }
+
+ private:
+  enum Pass { kMeasure, kFill };
+
+  struct Entry {
+    // Offset of the first line start in the kernel binary.
+    intptr_t offset;
+    intptr_t count;
+    int32_t max_delta;
+    // Set by the mutator before the fill pass.
+    void* data;
+    intptr_t cid;
+  };
+
+  class Task : public ThreadPool::Task {
+   public:
+    explicit Task(LineStartsDecoder* decoder) : decoder_(decoder) {}
+
+    virtual void Run() {
+      decoder_->RunPassOnCurrentThread();
+      decoder_->TaskDone();
+    }
+
+   private:
+    LineStartsDecoder* decoder_;
+
+    DISALLOW_COPY_AND_ASSIGN(Task);
+  };
+
+  // Line starts are delta encoded, and stored as tightly as possible, see
+  // KernelReaderHelper::GetLineStartsFor.
+  static intptr_t CidFor(int32_t max_delta) {
+    if (max_delta <= kMaxInt8) {
+      return kTypedDataInt8ArrayCid;
+    } else if (max_delta <= kMaxInt16) {
+      return kTypedDataInt16ArrayCid;
+    }
+    return kTypedDataInt32ArrayCid;
+  }
+
+  void RunPass(Pass pass, intptr_t num_tasks) {
+    pass_ = pass;
+    next_index_ = 0;
+    pending_tasks_ = num_tasks;
+    for (intptr_t i = 0; i < num_tasks; i++) {
+      Task* task = new Task(this);
+      if (!Dart::thread_pool()->Run(task)) {
+        delete task;
+        TaskDone();
+      }
+    }
+    RunPassOnCurrentThread();
+    MonitorLocker ml(&monitor_);
+    while (pending_tasks_ > 0) {
+      ml.Wait();
+    }
+  }
+
+  void RunPassOnCurrentThread() {
+    Reader reader(buffer_, size_);
+    for (intptr_t index = AtomicOperations::FetchAndIncrement(&next_index_);
+         index < count_;
+         index = AtomicOperations::FetchAndIncrement(&next_index_)) {
+      if (pass_ == kMeasure) {
+        Measure(&reader, &entries_[index], index);
+      } else {
+        Fill(&reader, &entries_[index]);
+      }
+    }
+  }
+
+  void Measure(Reader* reader, Entry* entry, intptr_t index) {
+    reader->set_offset(
+        reader->ReadFromIndexNoReset(source_table_end_, 0, count_, index));
+    reader->set_offset(reader->offset() + reader->ReadUInt());  // skip uri.
+    reader->set_offset(reader->offset() + reader->ReadUInt());  // skip source.
+    entry->count = reader->ReadUInt();
+    entry->offset = reader->offset();
+    int32_t max_delta = 0;
+    for (intptr_t i = 0; i < entry->count; ++i) {
+      const int32_t delta = reader->ReadUInt();
+      if (delta > max_delta) {
+        max_delta = delta;
+      }
+    }
+    entry->max_delta = max_delta;
+  }
+
+  void Fill(Reader* reader, const Entry* entry) {
+    reader->set_offset(entry->offset);
+    switch (entry->cid) {
+      case kTypedDataInt8ArrayCid: {
+        int8_t* data = reinterpret_cast<int8_t*>(entry->data);
+        for (intptr_t i = 0; i < entry->count; ++i) {
+          data[i] = static_cast<int8_t>(reader->ReadUInt());
+        }
+        break;
+      }
+      case kTypedDataInt16ArrayCid: {
+        int16_t* data = reinterpret_cast<int16_t*>(entry->data);
+        for (intptr_t i = 0; i < entry->count; ++i) {
+          data[i] = static_cast<int16_t>(reader->ReadUInt());
+        }
+        break;
+      }
+      case kTypedDataInt32ArrayCid: {
+        int32_t* data = reinterpret_cast<int32_t*>(entry->data);
+        for (intptr_t i = 0; i < entry->count; ++i) {
+          data[i] = static_cast<int32_t>(reader->ReadUInt());
+        }
+        break;
+      }
+      default:
+        UNREACHABLE();
+    }
+  }
+
+  void TaskDone() {
+    MonitorLocker ml(&monitor_);
+    ASSERT(pending_tasks_ > 0);
+    if (--pending_tasks_ == 0) {
+      ml.Notify();
+    }
+  }
+
+  Zone* zone_;
+  const uint8_t* buffer_;
+  const intptr_t size_;
+  const intptr_t source_table_end_;
+  intptr_t count_;
+  Array& line_starts_;
+  Entry* entries_;
+  Pass pass_;
+  intptr_t next_index_;
+  Monitor monitor_;
+  intptr_t pending_tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(LineStartsDecoder);
+};
+
 RawArray* KernelLoader::MakeFieldsArray() {
   const intptr_t len = fields_.length();
   const Array& res = Array::Handle(zone_, Array::New(len, Heap::kOld));
@@ -332,6 +547,12 @@ void KernelLoader::InitializeFields() {
       Z, reader.ExternalDataFromTo(program_->constant_table_offset(),
                                    program_->kernel_data_size()));
 
+  // Create a view of the source table, so script sources can be read on
+  // demand instead of being copied into the heap up front.
+  const ExternalTypedData& source_table = ExternalTypedData::Handle(
+      Z, reader.ExternalDataFromTo(program_->source_table_offset(),
+                                   program_->name_table_offset()));
+
   // Copy the canonical names into the VM's heap.  Encode them as unsigned, so
   // the parent indexes are adjusted when extracted.
   reader.set_offset(program_->name_table_offset());
@@ -364,13 +585,15 @@ void KernelLoader::InitializeFields() {
 
   kernel_program_info_ = KernelProgramInfo::New(
       offsets, data, names, metadata_payloads, metadata_mappings,
-      constants_table, scripts, libraries_cache, classes_cache);
+      constants_table, source_table, scripts, libraries_cache, classes_cache);
 
   H.InitFromKernelProgramInfo(kernel_program_info_);
 
+  LineStartsDecoder line_starts(Z, program_);
+  const bool line_starts_decoded = line_starts.Decode();
   Script& script = Script::Handle(Z);
   for (intptr_t index = 0; index < source_table_size; ++index) {
-    script = LoadScriptAt(index);
+    script = LoadScriptAt(index, line_starts_decoded ? &line_starts : NULL);
     scripts.SetAt(index, script);
   }
 
@@ -1948,14 +2171,74 @@ const Object& KernelLoader::ClassForScriptAt(const Class& klass,
   return klass;
 }
 
-RawScript* KernelLoader::LoadScriptAt(intptr_t index) {
+// Finds the source of |script| in the source table of its kernel program.
+// Returns the size of the UTF-8 encoded source, which is 0 if the source is
+// not available, and sets |*offset| to where it starts in |source_table|.
+static intptr_t FindSourceInTable(const Script& script,
+                                  const ExternalTypedData& source_table,
+                                  intptr_t* offset) {
+  if (source_table.IsNull()) {
+    return 0;
+  }
+
+  // The source table is the uint32 entry count, the (uri, source, line
+  // starts) entries and an index of their whole program offsets. The first
+  // entry immediately follows the entry count.
+  Reader reader(source_table);
+  const intptr_t index = script.kernel_script_index();
+  const intptr_t end = reader.size();
+  const intptr_t count = reader.ReadUInt32();
+  ASSERT((index >= 0) && (index < count));
+  const intptr_t table_offset = reader.ReadFromIndex(end, 0, count, 0) - 4;
+  reader.set_offset(reader.ReadFromIndex(end, 0, count, index) - table_offset);
+  reader.set_offset(reader.offset() + reader.ReadUInt());  // skip uri.
+  const intptr_t size = reader.ReadUInt();  // read source List<byte> size.
+  *offset = reader.offset();
+  return size;
+}
+
+static RawExternalTypedData* SourceTableFor(Zone* zone, const Script& script) {
+  const KernelProgramInfo& info =
+      KernelProgramInfo::Handle(zone, script.kernel_program_info());
+  if (info.IsNull()) {
+    return ExternalTypedData::null();
+  }
+  return info.source_table();
+}
+
+RawString* KernelLoader::ReadSourceFor(const Script& script) {
+  Zone* zone = Thread::Current()->zone();
+  const ExternalTypedData& source_table =
+      ExternalTypedData::Handle(zone, SourceTableFor(zone, script));
+  intptr_t offset = 0;
+  const intptr_t size = FindSourceInTable(script, source_table, &offset);
+  if (size == 0) {
+    return String::null();
+  }
+  return String::FromUTF8(
+      reinterpret_cast<const uint8_t*>(source_table.DataAddr(offset)), size,
+      Heap::kOld);
+}
+
+bool KernelLoader::HasSourceFor(const Script& script) {
+  Zone* zone = Thread::Current()->zone();
+  const ExternalTypedData& source_table =
+      ExternalTypedData::Handle(zone, SourceTableFor(zone, script));
+  intptr_t offset = 0;
+  return FindSourceInTable(script, source_table, &offset) > 0;
+}
+
+RawScript* KernelLoader::LoadScriptAt(intptr_t index,
+                                     LineStartsDecoder* decoded_line_starts) {
   const String& uri_string = helper_.SourceTableUriFor(index);
-  const String& script_source = helper_.GetSourceFor(index);
   String& sources = String::Handle(Z);
-  TypedData& line_starts =
-      TypedData::Handle(Z, helper_.GetLineStartsFor(index));
-  if (script_source.raw() == Symbols::Empty().raw() &&
-      line_starts.Length() == 0 && uri_string.Length() > 0) {
+  TypedData& line_starts = TypedData::Handle(
+      Z, decoded_line_starts != NULL ? decoded_line_starts->LineStartsAt(index)
+                                     : helper_.GetLineStartsFor(index));
+  if (helper_.SourceSizeFor(index) > 0) {
+    // The source is read from the kernel binary the first time it is needed,
+    // see Script::Source().
+  } else if (line_starts.Length() == 0 && uri_string.Length() > 0) {
     // Entry included only to provide URI - actual source should already exist
     // in the VM, so try to find it.
     Library& lib = Library::Handle(Z);
@@ -1972,7 +2255,7 @@ RawScript* KernelLoader::LoadScriptAt(intptr_t index) {
       }
     }
   } else {
-    sources = script_source.raw();
+    sources = Symbols::Empty().raw();
   }
 
   const Script& script = Script::Handle(
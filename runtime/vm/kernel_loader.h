@@ -19,6 +19,7 @@ namespace dart {
 namespace kernel {
 
 class KernelLoader;
+class LineStartsDecoder;
 
 class BuildingTranslationHelper : public TranslationHelper {
  public:
@@ -180,6 +181,14 @@ class KernelLoader : public ValueObject {
                                         intptr_t kernel_buffer_length,
                                         const String& url);
 
+  // Reads the source of a kernel script from the source table of its
+  // program. Returns null if the source is not available.
+  static RawString* ReadSourceFor(const Script& script);
+
+  // Returns whether the source of a kernel script is available, without
+  // reading it.
+  static bool HasSourceFor(const Script& script);
+
   RawLibrary* LoadLibrary(intptr_t index);
 
   void FinishTopLevelClassLoading(const Class& toplevel_class,
@@ -288,7 +297,7 @@ class KernelLoader : public ValueObject {
   RawArray* MakeFieldsArray();
   RawArray* MakeFunctionsArray();
 
-  RawScript* LoadScriptAt(intptr_t index);
+  RawScript* LoadScriptAt(intptr_t index, LineStartsDecoder* line_starts);
 
   // If klass's script is not the script at the uri index, return a PatchClass
   // for klass whose script corresponds to the uri index.
@@ -0,0 +1,137 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/kernel_loader.h"
+
+#include "platform/assert.h"
+#include "platform/text_buffer.h"
+#include "vm/compiler/frontend/kernel_translation_helper.h"
+#include "vm/dart_api_impl.h"
+#include "vm/os.h"
+#include "vm/symbols.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+
+// Exposes the serial line starts decoder that the loader's helper tasks
+// must agree with.
+class LineStartsReaderHelper : public kernel::KernelReaderHelper {
+ public:
+  LineStartsReaderHelper(Zone* zone,
+                         kernel::TranslationHelper* translation_helper,
+                         const uint8_t* buffer,
+                         intptr_t buffer_length)
+      : kernel::KernelReaderHelper(zone,
+                                   translation_helper,
+                                   buffer,
+                                   buffer_length,
+                                   0) {}
+
+  using kernel::KernelReaderHelper::GetLineStartsFor;
+};
+
+// Libraries get between 0 and 39 lines of varying length, so their line
+// starts use all of the Int8, Int16 and Int32 encodings.
+static char* LineStartsLibrarySource(intptr_t index) {
+  TextBuffer buffer(1024);
+  for (intptr_t line = 0; line < index % 40; line++) {
+    buffer.Printf("int f%" Pd "_%" Pd "() => %" Pd ";", index, line, line);
+    if (line % 7 == 0) {
+      buffer.AddString(" //");
+      for (intptr_t i = 0; i < (index % 3 == 0 ? 200 : 20); i++) {
+        buffer.AddChar('x');
+      }
+    }
+    if (line == 3 && index % 50 == 0) {
+      buffer.AddString(" //");
+      for (intptr_t i = 0; i < 40000; i++) {
+        buffer.AddChar('y');
+      }
+    }
+    buffer.AddChar('\n');
+  }
+  return buffer.Steal();
+}
+
+TEST_CASE(KernelLoader_LineStartsOnHelperTasks) {
+  // Enough scripts for the loader to start all of its helper tasks.
+  const intptr_t kNumLibraries = 400;
+  SetFlagScope<int> sfs(&FLAG_kernel_loader_tasks, 3);
+
+  Dart_SourceFile* sourcefiles = new Dart_SourceFile[kNumLibraries + 1];
+  TextBuffer main_source(16 * KB);
+  for (intptr_t i = 0; i < kNumLibraries; i++) {
+    char* uri = OS::SCreate(NULL, "file:///lib%" Pd ".dart", i);
+    main_source.Printf("import '%s';\n", uri);
+    sourcefiles[i + 1].uri = uri;
+    sourcefiles[i + 1].source = LineStartsLibrarySource(i);
+  }
+  main_source.AddString("main() {}\n");
+  sourcefiles[0].uri = "file:///test-lib";
+  sourcefiles[0].source = main_source.buf();
+
+  const uint8_t* kernel_buffer = NULL;
+  intptr_t kernel_buffer_size = 0;
+  char* error = TestCase::CompileTestScriptWithDFE(
+      sourcefiles[0].uri, kNumLibraries + 1, sourcefiles, &kernel_buffer,
+      &kernel_buffer_size);
+  EXPECT(error == NULL);
+  EXPECT(kernel_buffer != NULL);
+  TestCaseBase::AddToKernelBuffers(kernel_buffer);
+  for (intptr_t i = 1; i <= kNumLibraries; i++) {
+    free(const_cast<char*>(sourcefiles[i].uri));
+    free(const_cast<char*>(sourcefiles[i].source));
+  }
+  delete[] sourcefiles;
+
+  Dart_Handle lib =
+      Dart_LoadLibraryFromKernel(kernel_buffer, kernel_buffer_size);
+  EXPECT_VALID(lib);
+  lib = Dart_LookupLibrary(NewString("file:///test-lib"));
+  EXPECT_VALID(lib);
+
+  TransitionNativeToVM transition(thread);
+  const Library& library =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(lib)));
+  const String& main_name = String::Handle(Symbols::New(thread, "main"));
+  const Function& main =
+      Function::Handle(library.LookupLocalFunction(main_name));
+  EXPECT(!main.IsNull());
+  const Script& main_script = Script::Handle(main.script());
+  const KernelProgramInfo& info =
+      KernelProgramInfo::Handle(main_script.kernel_program_info());
+  const Array& scripts = Array::Handle(info.scripts());
+  EXPECT(scripts.Length() > kNumLibraries);
+
+  kernel::TranslationHelper translation_helper(thread);
+  LineStartsReaderHelper helper(thread->zone(), &translation_helper,
+                                kernel_buffer, kernel_buffer_size);
+  Script& script = Script::Handle();
+  TypedData& actual = TypedData::Handle();
+  TypedData& expected = TypedData::Handle();
+  for (intptr_t index = 0; index < scripts.Length(); index++) {
+    script ^= scripts.At(index);
+    actual = script.line_starts();
+    expected = helper.GetLineStartsFor(index);
+    if (expected.IsNull()) {
+      EXPECT(actual.IsNull());
+      continue;
+    }
+    EXPECT_EQ(expected.GetClassId(), actual.GetClassId());
+    EXPECT_EQ(expected.Length(), actual.Length());
+    if ((expected.GetClassId() != actual.GetClassId()) ||
+        (expected.Length() != actual.Length())) {
+      continue;
+    }
+    NoSafepointScope no_safepoint;
+    EXPECT(memcmp(expected.DataAddr(0), actual.DataAddr(0),
+                  expected.LengthInBytes()) == 0);
+  }
+}
+
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
+}  // namespace dart
@@ -1170,6 +1170,14 @@ void Object::FinalizeReadOnlyObject(RawObject* object) {
     ASSERT(size <= desc->HeapSize());
     memset(reinterpret_cast<void*>(RawObject::ToAddr(desc) + size), 0,
            desc->HeapSize() - size);
+  } else if (cid == kDoubleCid) {
+    // On 32-bit targets the value is 8-byte aligned, leaving a gap after the
+    // header.
+    RawDouble* dbl = Double::RawCast(object);
+    const intptr_t header_size = sizeof(RawObject);
+    const intptr_t value_offset = Double::value_offset();
+    memset(reinterpret_cast<void*>(RawObject::ToAddr(dbl) + header_size), 0,
+           value_offset - header_size);
   }
 }
 
@@ -9058,10 +9066,30 @@ void Field::ForceDynamicGuardedCidAndLength() const {
 }
 
 bool Script::HasSource() const {
-  return raw_ptr()->source_ != String::null();
+  if (raw_ptr()->source_ != String::null()) {
+    return true;
+  }
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  if (kind() == RawScript::kKernelTag) {
+    // Don't decode the source just to find out whether there is one.
+    return kernel::KernelLoader::HasSourceFor(*this);
+  }
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+  return false;
 }
 
 RawString* Script::Source() const {
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  if ((raw_ptr()->source_ == String::null()) &&
+      (kind() == RawScript::kKernelTag)) {
+    // This is read lazily from the kernel binary. Now we need it.
+    const String& source =
+        String::Handle(kernel::KernelLoader::ReadSourceFor(*this));
+    if (!source.IsNull()) {
+      set_source(source);
+    }
+  }
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
   return raw_ptr()->source_;
 }
 
@@ -11862,6 +11890,7 @@ RawKernelProgramInfo* KernelProgramInfo::New(
     const ExternalTypedData& metadata_payloads,
     const ExternalTypedData& metadata_mappings,
     const ExternalTypedData& constants_table,
+    const ExternalTypedData& source_table,
     const Array& scripts,
     const Array& libraries_cache,
     const Array& classes_cache) {
@@ -11876,6 +11905,7 @@ RawKernelProgramInfo* KernelProgramInfo::New(
                     metadata_mappings.raw());
   info.StorePointer(&info.raw_ptr()->scripts_, scripts.raw());
   info.StorePointer(&info.raw_ptr()->constants_table_, constants_table.raw());
+  info.StorePointer(&info.raw_ptr()->source_table_, source_table.raw());
   info.StorePointer(&info.raw_ptr()->libraries_cache_, libraries_cache.raw());
   info.StorePointer(&info.raw_ptr()->classes_cache_, classes_cache.raw());
   return info.raw();
@@ -14049,11 +14079,15 @@ RawICData* ICData::NewFrom(const ICData& from, intptr_t num_args_tested) {
 }
 
 RawICData* ICData::Clone(const ICData& from) {
+  return CloneWithDeoptId(from, from.deopt_id());
+}
+
+RawICData* ICData::CloneWithDeoptId(const ICData& from, intptr_t deopt_id) {
   Zone* zone = Thread::Current()->zone();
   const ICData& result = ICData::Handle(ICData::NewDescriptor(
       zone, Function::Handle(zone, from.Owner()),
       String::Handle(zone, from.target_name()),
-      Array::Handle(zone, from.arguments_descriptor()), from.deopt_id(),
+      Array::Handle(zone, from.arguments_descriptor()), deopt_id,
       from.NumArgsTested(), from.rebind_rule(),
       AbstractType::Handle(from.StaticReceiverType())));
   // Clone entry array.
@@ -14439,6 +14473,65 @@ class CodeCommentsWrapper final : public CodeComments {
   String& string_;
 };
 
+class CodeSourcePositionsWrapper final : public CodeSourcePositions {
+ public:
+  explicit CodeSourcePositionsWrapper(const Code& code)
+      : script_(Script::Handle()), url_(String::Handle()) {
+    const auto& map = CodeSourceMap::Handle(code.code_source_map());
+    if (map.IsNull() || !code.IsFunctionCode()) {
+      return;  // Stub code.
+    }
+    const auto& id_map = Array::Handle(code.inlined_id_to_function());
+    const auto& root = Function::Handle(code.function());
+    CodeSourceMapReader reader(map, id_map, root);
+    reader.GetInnermostPositions(&pc_offsets_, &functions_, &token_positions_);
+  }
+
+  intptr_t Length() const override { return pc_offsets_.length(); }
+
+  intptr_t PCOffsetAt(intptr_t i) const override { return pc_offsets_[i]; }
+
+  const char* FileAt(intptr_t i) const override {
+    script_ = functions_[i]->script();
+    if (script_.IsNull()) {
+      return nullptr;
+    }
+    url_ = script_.url();
+    return url_.ToCString();
+  }
+
+  intptr_t LineAt(intptr_t i) const override {
+    intptr_t line = 0, column = 0;
+    GetLocation(i, &line, &column);
+    return line;
+  }
+
+  intptr_t ColumnAt(intptr_t i) const override {
+    intptr_t line = 0, column = 0;
+    GetLocation(i, &line, &column);
+    return column;
+  }
+
+ private:
+  void GetLocation(intptr_t i, intptr_t* line, intptr_t* column) const {
+    TokenPosition token_pos = token_positions_[i];
+    if (token_pos.IsSynthetic()) {
+      token_pos = token_pos.FromSynthetic();
+    }
+    script_ = functions_[i]->script();
+    if (script_.IsNull() || !token_pos.IsReal()) {
+      return;
+    }
+    script_.GetTokenLocation(token_pos, line, column);
+  }
+
+  GrowableArray<int32_t> pc_offsets_;
+  GrowableArray<const Function*> functions_;
+  GrowableArray<TokenPosition> token_positions_;
+  Script& script_;
+  String& url_;
+};
+
 static const Code::Comments& CreateCommentsFrom(
     compiler::Assembler* assembler) {
   const auto& comments = assembler->comments();
@@ -14619,9 +14712,10 @@ void Code::NotifyCodeObservers(const char* name,
   if (CodeObservers::AreActive()) {
     const auto& instrs = Instructions::Handle(code.instructions());
     CodeCommentsWrapper comments_wrapper(code.comments());
+    CodeSourcePositionsWrapper positions_wrapper(code);
     CodeObservers::NotifyAll(name, instrs.PayloadStart(),
                              code.GetPrologueOffset(), instrs.Size(), optimized,
-                             &comments_wrapper);
+                             &comments_wrapper, &positions_wrapper);
   }
 #endif
 }
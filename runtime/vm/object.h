@@ -1813,6 +1813,9 @@ class ICData : public Object {
   // Generates a new ICData with descriptor and data array copied (deep clone).
   static RawICData* Clone(const ICData& from);
 
+  // Same as Clone, but the copy is given |deopt_id| instead.
+  static RawICData* CloneWithDeoptId(const ICData& from, intptr_t deopt_id);
+
   static intptr_t TestEntryLengthFor(intptr_t num_args,
                                      bool tracking_exactness);
 
@@ -3959,6 +3962,7 @@ class KernelProgramInfo : public Object {
                                    const ExternalTypedData& metadata_payload,
                                    const ExternalTypedData& metadata_mappings,
                                    const ExternalTypedData& constants_table,
+                                   const ExternalTypedData& source_table,
                                    const Array& scripts,
                                    const Array& libraries_cache,
                                    const Array& classes_cache);
@@ -3987,6 +3991,12 @@ class KernelProgramInfo : public Object {
 
   void set_constants_table(const ExternalTypedData& value) const;
 
+  // View of the component's source table. Used to read script sources on
+  // demand; not preserved in snapshots.
+  RawExternalTypedData* source_table() const {
+    return raw_ptr()->source_table_;
+  }
+
   RawArray* scripts() const { return raw_ptr()->scripts_; }
   void set_scripts(const Array& scripts) const;
 
@@ -6,6 +6,7 @@
 
 #include "vm/dart.h"
 #include "vm/dart_api_state.h"
+#include "vm/datastream.h"
 #include "vm/growable_array.h"
 #include "vm/isolate.h"
 #include "vm/object.h"
@@ -514,7 +515,8 @@ intptr_t ObjectGraph::InboundReferences(Object* obj, const Array& references) {
   return visitor.length();
 }
 
-static void WritePtr(RawObject* raw, WriteStream* stream) {
+template <typename Stream>
+static void WritePtr(RawObject* raw, Stream* stream) {
   ASSERT(raw->IsHeapObject());
   ASSERT(raw->IsOldObject());
   uword addr = RawObject::ToAddr(raw);
@@ -525,11 +527,10 @@ static void WritePtr(RawObject* raw, WriteStream* stream) {
   stream->WriteUnsigned(addr / kObjectAlignment);
 }
 
+template <typename Stream>
 class WritePointerVisitor : public ObjectPointerVisitor {
  public:
-  WritePointerVisitor(Isolate* isolate,
-                      WriteStream* stream,
-                      bool only_instances)
+  WritePointerVisitor(Isolate* isolate, Stream* stream, bool only_instances)
       : ObjectPointerVisitor(isolate),
         stream_(stream),
         only_instances_(only_instances),
@@ -554,25 +555,47 @@ class WritePointerVisitor : public ObjectPointerVisitor {
   intptr_t count() const { return count_; }
 
  private:
-  WriteStream* stream_;
+  Stream* stream_;
   bool only_instances_;
   intptr_t count_;
 };
 
+template <typename Stream>
 static void WriteHeader(RawObject* raw,
                         intptr_t size,
                         intptr_t cid,
-                        WriteStream* stream) {
+                        Stream* stream) {
   WritePtr(raw, stream);
   ASSERT(Utils::IsAligned(size, kObjectAlignment));
   stream->WriteUnsigned(size);
   stream->WriteUnsigned(cid);
 }
 
+template <typename Stream>
+static bool WriteNode(RawObject* raw_obj,
+                      ObjectGraph::SnapshotRoots roots,
+                      WritePointerVisitor<Stream>* ptr_writer,
+                      Stream* stream) {
+  Thread* thread = Thread::Current();
+  REUSABLE_OBJECT_HANDLESCOPE(thread);
+  Object& obj = thread->ObjectHandle();
+  obj = raw_obj;
+  if ((roots == ObjectGraph::kVM) || obj.IsField() || obj.IsInstance() ||
+      obj.IsContext()) {
+    // Each object is a header + a zero-terminated list of its neighbors.
+    WriteHeader(raw_obj, raw_obj->HeapSize(), obj.GetClassId(), stream);
+    raw_obj->VisitPointers(ptr_writer);
+    stream->WriteUnsigned(0);
+    return true;
+  }
+  return false;
+}
+
+template <typename Stream>
 class WriteGraphVisitor : public ObjectGraph::Visitor {
  public:
   WriteGraphVisitor(Isolate* isolate,
-                    WriteStream* stream,
+                    Stream* stream,
                     ObjectGraph::SnapshotRoots roots)
       : stream_(stream),
         ptr_writer_(isolate, stream, roots == ObjectGraph::kUser),
@@ -580,17 +603,7 @@ class WriteGraphVisitor : public ObjectGraph::Visitor {
         count_(0) {}
 
   virtual Direction VisitObject(ObjectGraph::StackIterator* it) {
-    RawObject* raw_obj = it->Get();
-    Thread* thread = Thread::Current();
-    REUSABLE_OBJECT_HANDLESCOPE(thread);
-    Object& obj = thread->ObjectHandle();
-    obj = raw_obj;
-    if ((roots_ == ObjectGraph::kVM) || obj.IsField() || obj.IsInstance() ||
-        obj.IsContext()) {
-      // Each object is a header + a zero-terminated list of its neighbors.
-      WriteHeader(raw_obj, raw_obj->HeapSize(), obj.GetClassId(), stream_);
-      raw_obj->VisitPointers(&ptr_writer_);
-      stream_->WriteUnsigned(0);
+    if (WriteNode(it->Get(), roots_, &ptr_writer_, stream_)) {
       ++count_;
     }
     return kProceed;
@@ -599,15 +612,47 @@ class WriteGraphVisitor : public ObjectGraph::Visitor {
   intptr_t count() const { return count_; }
 
  private:
-  WriteStream* stream_;
-  WritePointerVisitor ptr_writer_;
+  Stream* stream_;
+  WritePointerVisitor<Stream> ptr_writer_;
   ObjectGraph::SnapshotRoots roots_;
   intptr_t count_;
 };
 
+// Writes every object in the heap in page order. Unlike WriteGraphVisitor this
+// needs no traversal stack, so its working set does not grow with the heap.
+template <typename Stream>
+class WriteHeapPagesVisitor : public ObjectVisitor {
+ public:
+  WriteHeapPagesVisitor(Isolate* isolate,
+                        Stream* stream,
+                        ObjectGraph::SnapshotRoots roots)
+      : stream_(stream),
+        ptr_writer_(isolate, stream, roots == ObjectGraph::kUser),
+        roots_(roots),
+        count_(0) {}
+
+  void VisitObject(RawObject* raw_obj) {
+    if (raw_obj->IsPseudoObject()) {
+      return;
+    }
+    if (WriteNode(raw_obj, roots_, &ptr_writer_, stream_)) {
+      ++count_;
+    }
+  }
+
+  intptr_t count() const { return count_; }
+
+ private:
+  Stream* stream_;
+  WritePointerVisitor<Stream> ptr_writer_;
+  ObjectGraph::SnapshotRoots roots_;
+  intptr_t count_;
+};
+
+template <typename Stream>
 class WriteGraphExternalSizesVisitor : public HandleVisitor {
  public:
-  WriteGraphExternalSizesVisitor(Thread* thread, WriteStream* stream)
+  WriteGraphExternalSizesVisitor(Thread* thread, Stream* stream)
       : HandleVisitor(thread), stream_(stream) {}
 
   void VisitHandle(uword addr) {
@@ -622,19 +667,11 @@ class WriteGraphExternalSizesVisitor : public HandleVisitor {
   }
 
  private:
-  WriteStream* stream_;
+  Stream* stream_;
 };
 
-intptr_t ObjectGraph::Serialize(WriteStream* stream,
-                                SnapshotRoots roots,
-                                bool collect_garbage) {
-  if (collect_garbage) {
-    isolate()->heap()->CollectAllGarbage();
-  }
-  // Current encoding assumes objects do not move, so promote everything to old.
-  isolate()->heap()->new_space()->Evacuate();
-  HeapIterationScope iteration_scope(Thread::Current(), true);
-
+template <typename Stream>
+void ObjectGraph::WriteRoots(Stream* stream, SnapshotRoots roots) {
   RawObject* kRootAddress = reinterpret_cast<RawObject*>(kHeapObjectTag);
   const intptr_t kRootCid = kIllegalCid;
   RawObject* kStackAddress =
@@ -648,7 +685,7 @@ intptr_t ObjectGraph::Serialize(WriteStream* stream,
   if (roots == kVM) {
     // Write root "object".
     WriteHeader(kRootAddress, 0, kRootCid, stream);
-    WritePointerVisitor ptr_writer(isolate(), stream, false);
+    WritePointerVisitor<Stream> ptr_writer(isolate(), stream, false);
     isolate()->VisitObjectPointers(&ptr_writer,
                                    ValidationPolicy::kDontValidateFrames);
     stream->WriteUnsigned(0);
@@ -656,7 +693,7 @@ intptr_t ObjectGraph::Serialize(WriteStream* stream,
     {
       // Write root "object".
       WriteHeader(kRootAddress, 0, kRootCid, stream);
-      WritePointerVisitor ptr_writer(isolate(), stream, false);
+      WritePointerVisitor<Stream> ptr_writer(isolate(), stream, false);
       IterateUserFields(&ptr_writer);
       WritePtr(kStackAddress, stream);
       stream->WriteUnsigned(0);
@@ -665,28 +702,66 @@ intptr_t ObjectGraph::Serialize(WriteStream* stream,
     {
       // Write stack "object".
       WriteHeader(kStackAddress, 0, kStackCid, stream);
-      WritePointerVisitor ptr_writer(isolate(), stream, true);
+      WritePointerVisitor<Stream> ptr_writer(isolate(), stream, true);
       isolate()->VisitStackPointers(&ptr_writer,
                                     ValidationPolicy::kDontValidateFrames);
       stream->WriteUnsigned(0);
     }
   }
+}
+
+template <typename Stream>
+static intptr_t WriteExternalSizes(Isolate* isolate,
+                                   ObjectGraph::SnapshotRoots roots,
+                                   intptr_t count,
+                                   Stream* stream) {
+  WriteGraphExternalSizesVisitor<Stream> external_visitor(Thread::Current(),
+                                                          stream);
+  isolate->VisitWeakPersistentHandles(&external_visitor);
+  stream->WriteUnsigned(0);
+
+  if (roots == ObjectGraph::kVM) {
+    return count + 1;  // root
+  } else {
+    return count + 2;  // root and stack
+  }
+}
+
+intptr_t ObjectGraph::Serialize(WriteStream* stream,
+                                SnapshotRoots roots,
+                                bool collect_garbage) {
+  if (collect_garbage) {
+    isolate()->heap()->CollectAllGarbage();
+  }
+  // Current encoding assumes objects do not move, so promote everything to old.
+  isolate()->heap()->new_space()->Evacuate();
+  HeapIterationScope iteration_scope(Thread::Current(), true);
+
+  WriteRoots(stream, roots);
 
-  WriteGraphVisitor visitor(isolate(), stream, roots);
+  WriteGraphVisitor<WriteStream> visitor(isolate(), stream, roots);
   IterateObjects(&visitor);
   stream->WriteUnsigned(0);
 
-  WriteGraphExternalSizesVisitor external_visitor(Thread::Current(), stream);
-  isolate()->VisitWeakPersistentHandles(&external_visitor);
+  return WriteExternalSizes(isolate(), roots, visitor.count(), stream);
+}
+
+intptr_t ObjectGraph::Serialize(StreamingWriteStream* stream,
+                                SnapshotRoots roots) {
+  // Walking pages instead of the graph only yields reachable objects right
+  // after a full collection.
+  isolate()->heap()->CollectAllGarbage();
+  isolate()->heap()->new_space()->Evacuate();
+  HeapIterationScope iteration_scope(Thread::Current(), true);
+
+  WriteRoots(stream, roots);
+
+  WriteHeapPagesVisitor<StreamingWriteStream> visitor(isolate(), stream,
+                                                      roots);
+  iteration_scope.IterateObjectsNoImagePages(&visitor);
   stream->WriteUnsigned(0);
 
-  intptr_t object_count = visitor.count();
-  if (roots == kVM) {
-    object_count += 1;  // root
-  } else {
-    object_count += 2;  // root and stack
-  }
-  return object_count;
+  return WriteExternalSizes(isolate(), roots, visitor.count(), stream);
 }
 
 }  // namespace dart
@@ -14,6 +14,7 @@ class Array;
 class Isolate;
 class Object;
 class RawObject;
+class StreamingWriteStream;
 class WriteStream;
 
 // Utility to traverse the object graph in an ordered fashion.
@@ -104,12 +105,21 @@ class ObjectGraph : public ThreadStackResource {
   // Returns the number of nodes in the stream, including the root.
   // If collect_garbage is false, the graph will include weakly-reachable
   // objects.
-  // TODO(koda): Document format; support streaming/chunking.
+  // TODO(koda): Document format.
   intptr_t Serialize(WriteStream* stream,
                      SnapshotRoots roots,
                      bool collect_garbage);
 
+  // Like the above, but flushes 'stream' as it goes and visits the heap in
+  // page order after a full collection instead of traversing the graph, so
+  // the memory used does not grow with the size of the heap. Uses the same
+  // format as above.
+  intptr_t Serialize(StreamingWriteStream* stream, SnapshotRoots roots);
+
  private:
+  template <typename Stream>
+  void WriteRoots(Stream* stream, SnapshotRoots roots);
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(ObjectGraph);
 };
 
@@ -4,6 +4,7 @@
 
 #include "vm/object_graph.h"
 #include "platform/assert.h"
+#include "vm/datastream.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -138,4 +139,218 @@ ISOLATE_UNIT_TEST_CASE(ObjectGraph) {
   }
 }
 
+struct StreamedSnapshot {
+  MallocGrowableArray<uint8_t> bytes;
+  intptr_t chunk_count;
+  intptr_t max_chunk_size;
+};
+
+static void CollectSnapshotChunk(void* callback_data,
+                                 const uint8_t* buffer,
+                                 intptr_t size) {
+  StreamedSnapshot* snapshot =
+      reinterpret_cast<StreamedSnapshot*>(callback_data);
+  for (intptr_t i = 0; i < size; i++) {
+    snapshot->bytes.Add(buffer[i]);
+  }
+  snapshot->chunk_count++;
+  snapshot->max_chunk_size = Utils::Maximum(snapshot->max_chunk_size, size);
+}
+
+// The nodes of a snapshot in the format written by ObjectGraph::Serialize.
+class SnapshotGraph {
+ public:
+  SnapshotGraph(const uint8_t* data, intptr_t length)
+      : node_count_(0), complete_(false) {
+    ReadStream stream(data, length);
+    if (stream.PendingBytes() < 4) {
+      return;
+    }
+    EXPECT_EQ(kObjectAlignment, stream.ReadUnsigned());
+    EXPECT_EQ(kStackCid, stream.ReadUnsigned());
+    EXPECT_EQ(kFieldCid, stream.ReadUnsigned());
+    stream.ReadUnsigned();  // Number of class ids.
+    // The first node is the root, whose id is 0. A 0 id ends the nodes.
+    while (stream.PendingBytes() > 0) {
+      const intptr_t id = stream.ReadUnsigned();
+      if ((id == 0) && (node_count_ > 0)) {
+        break;
+      }
+      nodes_.Add(id);
+      sizes_.Add(stream.ReadUnsigned());
+      cids_.Add(stream.ReadUnsigned());
+      first_edges_.Add(edges_.length());
+      node_count_++;
+      while (stream.PendingBytes() > 0) {
+        const intptr_t target = stream.ReadUnsigned();
+        if (target == 0) {
+          break;
+        }
+        edges_.Add(target);
+      }
+    }
+    first_edges_.Add(edges_.length());
+    // External sizes of weak persistent handles, ended by a 0 id.
+    while (stream.PendingBytes() > 0) {
+      const intptr_t id = stream.ReadUnsigned();
+      if (id == 0) {
+        complete_ = (stream.PendingBytes() == 0);
+        break;
+      }
+      stream.ReadUnsigned();  // External size.
+    }
+    sorted_nodes_.AddArray(nodes_);
+    sorted_nodes_.Sort(CompareIds);
+  }
+
+  intptr_t node_count() const { return node_count_; }
+
+  // Whether the whole stream was consumed by a well-formed snapshot.
+  bool complete() const { return complete_; }
+
+  bool HasNode(intptr_t id) const {
+    intptr_t lo = 0;
+    intptr_t hi = sorted_nodes_.length() - 1;
+    while (lo <= hi) {
+      const intptr_t mid = lo + (hi - lo) / 2;
+      if (sorted_nodes_[mid] == id) {
+        return true;
+      } else if (sorted_nodes_[mid] < id) {
+        lo = mid + 1;
+      } else {
+        hi = mid - 1;
+      }
+    }
+    return false;
+  }
+
+  // Returns the index of the node with the given id or -1.
+  intptr_t IndexOf(intptr_t id) const {
+    for (intptr_t i = 0; i < nodes_.length(); i++) {
+      if (nodes_[i] == id) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  intptr_t size(intptr_t index) const { return sizes_[index]; }
+  intptr_t cid(intptr_t index) const { return cids_[index]; }
+
+  bool HasEdge(intptr_t index, intptr_t target) const {
+    for (intptr_t i = first_edges_[index]; i < first_edges_[index + 1]; i++) {
+      if (edges_[i] == target) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Whether every edge leads to a node of the snapshot.
+  bool IsClosed() const {
+    for (intptr_t i = 0; i < edges_.length(); i++) {
+      if (!HasNode(edges_[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Whether every node of 'other' is also a node of this snapshot.
+  bool Contains(const SnapshotGraph& other) const {
+    for (intptr_t i = 0; i < other.nodes_.length(); i++) {
+      if (!HasNode(other.nodes_[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  static int CompareIds(const intptr_t* a, const intptr_t* b) {
+    return (*a < *b) ? -1 : ((*a > *b) ? 1 : 0);
+  }
+
+  intptr_t node_count_;
+  bool complete_;
+  MallocGrowableArray<intptr_t> nodes_;
+  MallocGrowableArray<intptr_t> sizes_;
+  MallocGrowableArray<intptr_t> cids_;
+  MallocGrowableArray<intptr_t> first_edges_;
+  MallocGrowableArray<intptr_t> edges_;
+  MallocGrowableArray<intptr_t> sorted_nodes_;
+
+  DISALLOW_COPY_AND_ASSIGN(SnapshotGraph);
+};
+
+static uint8_t* malloc_allocator(uint8_t* ptr,
+                                 intptr_t old_size,
+                                 intptr_t new_size) {
+  return reinterpret_cast<uint8_t*>(realloc(ptr, new_size));
+}
+
+static intptr_t SnapshotId(const Object& obj) {
+  return RawObject::ToAddr(obj.raw()) / kObjectAlignment;
+}
+
+ISOLATE_UNIT_TEST_CASE(ObjectGraph_StreamingSerialize) {
+  // a -> b -> c, all kept alive by handles.
+  const Array& a = Array::Handle(Array::New(3, Heap::kOld));
+  const Array& b = Array::Handle(Array::New(2, Heap::kOld));
+  const Array& c = Array::Handle(Array::New(1, Heap::kOld));
+  a.SetAt(1, b);
+  b.SetAt(0, c);
+
+  const intptr_t kChunkSize = 4 * KB;
+  StreamedSnapshot snapshot;
+  snapshot.chunk_count = 0;
+  snapshot.max_chunk_size = 0;
+  intptr_t node_count;
+  {
+    StreamingWriteStream stream(kChunkSize, CollectSnapshotChunk, &snapshot);
+    ObjectGraph graph(thread);
+    node_count = graph.Serialize(&stream, ObjectGraph::kVM);
+  }
+  EXPECT(node_count > 1);
+  EXPECT(snapshot.chunk_count > 1);
+  EXPECT(snapshot.max_chunk_size <= kChunkSize);
+
+  SnapshotGraph streamed(snapshot.bytes.data(), snapshot.bytes.length());
+  EXPECT(streamed.complete());
+  EXPECT_EQ(node_count, streamed.node_count());
+  // Walking the heap pages after a full collection yields every object its
+  // nodes refer to.
+  EXPECT(streamed.IsClosed());
+
+  const intptr_t a_index = streamed.IndexOf(SnapshotId(a));
+  const intptr_t b_index = streamed.IndexOf(SnapshotId(b));
+  EXPECT(a_index >= 0);
+  EXPECT(b_index >= 0);
+  if ((a_index >= 0) && (b_index >= 0)) {
+    EXPECT_EQ(kArrayCid, streamed.cid(a_index));
+    EXPECT_EQ(a.raw()->HeapSize(), streamed.size(a_index));
+    EXPECT(streamed.HasEdge(a_index, SnapshotId(b)));
+    EXPECT(!streamed.HasEdge(a_index, SnapshotId(c)));
+    EXPECT(streamed.HasEdge(b_index, SnapshotId(c)));
+  }
+  EXPECT(streamed.HasNode(SnapshotId(c)));
+
+  // Every object reachable in the graph traversal of the buffered writer is
+  // also written by the streaming one.
+  uint8_t* buffer = NULL;
+  WriteStream buffer_stream(&buffer, &malloc_allocator, KB);
+  intptr_t buffered_count;
+  {
+    ObjectGraph graph(thread);
+    buffered_count = graph.Serialize(&buffer_stream, ObjectGraph::kVM, true);
+  }
+  {
+    SnapshotGraph buffered(buffer, buffer_stream.bytes_written());
+    EXPECT(buffered.complete());
+    EXPECT_EQ(buffered_count, buffered.node_count());
+    EXPECT(streamed.Contains(buffered));
+  }
+  free(buffer);
+}
+
 }  // namespace dart
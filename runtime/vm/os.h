@@ -78,6 +78,11 @@ class OS {
   // Returns number of available processor cores.
   static int NumberOfAvailableProcessors();
 
+  // Returns the amount of memory in bytes this process may use: the memory
+  // limit of its container where the platform has one, otherwise the size
+  // of physical memory. Returns 0 if unknown.
+  static int64_t GetMemoryLimit();
+
   // Sleep the currently executing thread for millis ms.
   static void Sleep(int64_t millis);
 
@@ -64,7 +64,8 @@ class PerfCodeObserver : public CodeObserver {
                       uword prologue_offset,
                       uword size,
                       bool optimized,
-                      const CodeComments* comments) {
+                      const CodeComments* comments,
+                      const CodeSourcePositions* positions) {
     Dart_FileWriteCallback file_write = Dart::file_write_callback();
     if ((file_write == NULL) || (out_file_ == NULL)) {
       return;
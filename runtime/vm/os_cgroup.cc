@@ -0,0 +1,60 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/globals.h"
+#if defined(HOST_OS_ANDROID) || defined(HOST_OS_LINUX)
+
+#include "vm/os.h"
+
+#include <stdio.h>   // NOLINT
+#include <stdlib.h>  // NOLINT
+#include <unistd.h>  // NOLINT
+
+#include "platform/utils.h"
+
+namespace dart {
+
+// Linux and Android expose the memory limit of a process through the same
+// cgroup files.
+
+// Reads a byte count from a cgroup control file. Returns 0 if the file does
+// not exist or holds no limit.
+static int64_t ReadCgroupMemoryLimit(const char* path) {
+  FILE* file = fopen(path, "r");
+  if (file == NULL) {
+    return 0;
+  }
+  char buffer[64];
+  int64_t limit = 0;
+  if (fgets(buffer, sizeof(buffer), file) != NULL) {
+    // cgroup v2 reports "max" when unlimited, which fails to parse.
+    char* end = NULL;
+    limit = strtoll(buffer, &end, 10);
+    if (end == buffer) {
+      limit = 0;
+    }
+  }
+  fclose(file);
+  return limit;
+}
+
+int64_t OS::GetMemoryLimit() {
+  const int64_t physical = static_cast<int64_t>(sysconf(_SC_PHYS_PAGES)) *
+                           static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+  // cgroup v1 reports a huge value when unlimited, so never exceed physical
+  // memory.
+  int64_t limit = ReadCgroupMemoryLimit("/sys/fs/cgroup/memory.max");
+  if (limit <= 0) {
+    limit =
+        ReadCgroupMemoryLimit("/sys/fs/cgroup/memory/memory.limit_in_bytes");
+  }
+  if ((limit <= 0) || ((physical > 0) && (limit > physical))) {
+    limit = physical;
+  }
+  return Utils::Maximum(limit, static_cast<int64_t>(0));
+}
+
+}  // namespace dart
+
+#endif  // defined(HOST_OS_ANDROID) || defined(HOST_OS_LINUX)
@@ -151,6 +151,10 @@ int OS::NumberOfAvailableProcessors() {
   return sysconf(_SC_NPROCESSORS_CONF);
 }
 
+int64_t OS::GetMemoryLimit() {
+  return zx_system_get_physmem();
+}
+
 void OS::Sleep(int64_t millis) {
   SleepMicros(millis * kMicrosecondsPerMillisecond);
 }
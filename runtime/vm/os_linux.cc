@@ -88,7 +88,8 @@ class PerfCodeObserver : public CodeObserver {
                       uword prologue_offset,
                       uword size,
                       bool optimized,
-                      const CodeComments* comments) {
+                      const CodeComments* comments,
+                      const CodeSourcePositions* positions) {
     Dart_FileWriteCallback file_write = Dart::file_write_callback();
     if ((file_write == NULL) || (out_file_ == NULL)) {
       return;
@@ -113,6 +114,10 @@ class PerfCodeObserver : public CodeObserver {
 // perf-inject to generate ELF images for JIT generated code objects, which
 // allows both perf-report and perf-annotate to recognize them.
 //
+// Debug info records map code to Dart source lines, using the innermost
+// inlined function at each PC. Stubs have no source positions, so their code
+// comments are written to side files instead.
+//
 // Usage:
 //
 //   $ perf record -k mono dart --generate-perf-jitdump benchmark.dart
@@ -194,14 +199,19 @@ class JitDumpCodeObserver : public CodeObserver {
                       uword prologue_offset,
                       uword size,
                       bool optimized,
-                      const CodeComments* comments) {
+                      const CodeComments* comments,
+                      const CodeSourcePositions* positions) {
     MutexLocker ml(CodeObservers::mutex());
 
     const char* marker = optimized ? "*" : "";
     char* buffer = OS::SCreate(Thread::Current()->zone(), "%s%s", marker, name);
     const size_t name_length = strlen(buffer);
 
-    WriteDebugInfo(base, comments);
+    if ((positions != nullptr) && (positions->Length() > 0)) {
+      WriteSourceDebugInfo(base, positions);
+    } else {
+      WriteDebugInfo(base, comments);
+    }
 
     CodeLoadEvent ev;
     ev.event = BaseEvent::kLoad;
@@ -357,6 +367,50 @@ class JitDumpCodeObserver : public CodeObserver {
     free(comments_file_name);
   }
 
+  // Maps each range of PCs to the Dart source line of the innermost inlined
+  // function, so perf attributes samples in inlined code to the right line.
+  void WriteSourceDebugInfo(uword base, const CodeSourcePositions* positions) {
+    const intptr_t length = positions->Length();
+    const char** files = Thread::Current()->zone()->Alloc<const char*>(length);
+    intptr_t entry_count = 0;
+    intptr_t size = sizeof(DebugInfoEvent);
+    for (intptr_t i = 0; i < length; i++) {
+      files[i] = positions->FileAt(i);
+      if (files[i] != nullptr) {
+        entry_count++;
+        size += sizeof(DebugInfoEntry) + strlen(files[i]) + 1;
+      }
+    }
+    if (entry_count == 0) {
+      return;
+    }
+
+    DebugInfoEvent info;
+    info.event = BaseEvent::kDebugInfo;
+    info.time_stamp = OS::GetCurrentMonotonicTicks();
+    info.address = base;
+    info.entry_count = entry_count;
+    info.size = size;
+    const int32_t padding = Utils::RoundUp(info.size, 8) - info.size;
+    info.size += padding;
+
+    WriteFully(&info, sizeof(info));
+    for (intptr_t i = 0; i < length; i++) {
+      if (files[i] == nullptr) {
+        continue;
+      }
+      DebugInfoEntry entry;
+      entry.address = base + positions->PCOffsetAt(i) + kElfHeaderSize;
+      entry.line_number = positions->LineAt(i);
+      entry.column = positions->ColumnAt(i);
+      WriteFully(&entry, sizeof(entry));
+      WriteFully(files[i], strlen(files[i]) + 1);
+    }
+
+    const char padding_bytes[8] = {0};
+    WriteFully(padding_bytes, padding);
+  }
+
   void WriteHeader() {
     Header header;
     header.elf_mach_target = GetElfMachineArchitecture();
@@ -373,6 +427,7 @@ class JitDumpCodeObserver : public CodeObserver {
     intptr_t line_count = 1;
     while ((comment = strstr(comment, "\n")) != nullptr) {
       line_count++;
+      comment++;
     }
     return line_count;
   }
@@ -13,6 +13,7 @@
 #include <mach/mach.h>       // NOLINT
 #include <mach/mach_time.h>  // NOLINT
 #include <sys/resource.h>    // NOLINT
+#include <sys/sysctl.h>      // NOLINT
 #include <sys/time.h>        // NOLINT
 #include <unistd.h>          // NOLINT
 #if HOST_OS_IOS
@@ -174,6 +175,15 @@ int OS::NumberOfAvailableProcessors() {
   return sysconf(_SC_NPROCESSORS_ONLN);
 }
 
+int64_t OS::GetMemoryLimit() {
+  int64_t memsize = 0;
+  size_t length = sizeof(memsize);
+  if (sysctlbyname("hw.memsize", &memsize, &length, NULL, 0) != 0) {
+    return 0;
+  }
+  return memsize;
+}
+
 void OS::Sleep(int64_t millis) {
   int64_t micros = millis * kMicrosecondsPerMillisecond;
   SleepMicros(micros);
@@ -38,6 +38,7 @@ VM_UNIT_TEST_CASE(OsFuncs) {
   EXPECT(Utils::IsPowerOfTwo(OS::PreferredCodeAlignment()));
   int procs = OS::NumberOfAvailableProcessors();
   EXPECT_LE(1, procs);
+  EXPECT_LE(0, OS::GetMemoryLimit());
 }
 
 }  // namespace dart
@@ -206,6 +206,15 @@ int OS::NumberOfAvailableProcessors() {
   return info.dwNumberOfProcessors;
 }
 
+int64_t OS::GetMemoryLimit() {
+  MEMORYSTATUSEX status;
+  status.dwLength = sizeof(status);
+  if (!GlobalMemoryStatusEx(&status)) {
+    return 0;
+  }
+  return static_cast<int64_t>(status.ullTotalPhys);
+}
+
 void OS::Sleep(int64_t millis) {
   ::Sleep(millis);
 }
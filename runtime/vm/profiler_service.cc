@@ -2522,6 +2522,263 @@ void Profile::AddToTimeline() {
   }
 }
 
+// Minimal encoder for the protocol buffer wire format, sufficient to write
+// the messages of pprof's profile.proto.
+class ProtobufWriter : public ValueObject {
+ public:
+  explicit ProtobufWriter(Zone* zone) : buffer_(zone, 64) {}
+
+  const uint8_t* data() const { return buffer_.data(); }
+  intptr_t length() const { return buffer_.length(); }
+  void Clear() { buffer_.Clear(); }
+
+  void WriteVarint(uint64_t value) {
+    while (value >= 0x80) {
+      buffer_.Add(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    buffer_.Add(static_cast<uint8_t>(value));
+  }
+
+  void WriteInt64(intptr_t field, int64_t value) {
+    WriteTag(field, kVarint);
+    WriteVarint(static_cast<uint64_t>(value));
+  }
+
+  void WriteBytes(intptr_t field, const uint8_t* data, intptr_t length) {
+    WriteTag(field, kLengthDelimited);
+    WriteVarint(length);
+    for (intptr_t i = 0; i < length; i++) {
+      buffer_.Add(data[i]);
+    }
+  }
+
+  void WriteString(intptr_t field, const char* value) {
+    WriteBytes(field, reinterpret_cast<const uint8_t*>(value), strlen(value));
+  }
+
+  void WriteMessage(intptr_t field, const ProtobufWriter& message) {
+    WriteBytes(field, message.data(), message.length());
+  }
+
+ private:
+  enum WireType {
+    kVarint = 0,
+    kLengthDelimited = 2,
+  };
+
+  void WriteTag(intptr_t field, WireType type) {
+    WriteVarint((static_cast<uint64_t>(field) << 3) | type);
+  }
+
+  GrowableArray<uint8_t> buffer_;
+};
+
+// Interns the strings of a pprof profile. Index 0 is always the empty string.
+class PprofStringTable : public ValueObject {
+ public:
+  explicit PprofStringTable(Zone* zone) : strings_(zone, 64), indices_(zone) {
+    strings_.Add("");
+  }
+
+  intptr_t Intern(const char* str) {
+    ASSERT(str != NULL);
+    if (str[0] == '\0') {
+      return 0;
+    }
+    intptr_t index = indices_.LookupValue(str);
+    if (index == 0) {
+      index = strings_.length();
+      strings_.Add(str);
+      indices_.Insert(StringIndexTrait::Pair(str, index));
+    }
+    return index;
+  }
+
+  void Write(ProtobufWriter* profile) const {
+    for (intptr_t i = 0; i < strings_.length(); i++) {
+      profile->WriteString(6, strings_[i]);  // Profile.string_table
+    }
+  }
+
+ private:
+  struct StringIndexTrait {
+    typedef const char* Key;
+    typedef intptr_t Value;
+
+    struct Pair {
+      Key key;
+      Value value;
+      Pair() : key(NULL), value(0) {}
+      Pair(const Key key, const Value& value) : key(key), value(value) {}
+      Pair(const Pair& other) : key(other.key), value(other.value) {}
+    };
+
+    static Key KeyOf(Pair kv) { return kv.key; }
+    static Value ValueOf(Pair kv) { return kv.value; }
+    static intptr_t Hashcode(Key key) {
+      return Utils::StringHash(key, strlen(key));
+    }
+    static bool IsKeyEqual(Pair kv, Key key) {
+      return strcmp(kv.key, key) == 0;
+    }
+  };
+
+  GrowableArray<const char*> strings_;
+  DirectChainedHashMap<StringIndexTrait> indices_;
+};
+
+static void WritePprofValueType(ProtobufWriter* message,
+                                intptr_t field,
+                                PprofStringTable* strings,
+                                const char* type,
+                                const char* unit) {
+  ProtobufWriter value_type(Thread::Current()->zone());
+  value_type.WriteInt64(1, strings->Intern(type));  // ValueType.type
+  value_type.WriteInt64(2, strings->Intern(unit));  // ValueType.unit
+  message->WriteMessage(field, value_type);
+}
+
+const uint8_t* Profile::EncodePprof(PprofKind kind, intptr_t* length) {
+  ScopeTimer sw("Profile::EncodePprof", FLAG_trace_profiler);
+  ProtobufWriter profile(zone_);
+  PprofStringTable strings(zone_);
+
+  // Profile.sample_type, matching the values written for each sample below.
+  if (kind == kCpuPprof) {
+    WritePprofValueType(&profile, 1, &strings, "samples", "count");
+    WritePprofValueType(&profile, 1, &strings, "cpu", "nanoseconds");
+  } else {
+    WritePprofValueType(&profile, 1, &strings, "alloc_objects", "count");
+    if (kind == kNativeAllocationPprof) {
+      WritePprofValueType(&profile, 1, &strings, "alloc_space", "bytes");
+    }
+  }
+
+  // Every sample maps to the node of the inclusive function trie at its
+  // innermost frame, so samples with identical stacks share a node.
+  ProfileTrieNode* root = GetTrieRoot(kInclusiveFunction);
+  if (root != NULL) {
+    AddParentTriePointers(root, NULL);
+  }
+  DirectChainedHashMap<RawPointerKeyValueTrait<ProfileTrieNode, intptr_t> >
+      stack_index(zone_);
+  GrowableArray<ProfileTrieNode*> stacks(zone_, 64);
+  GrowableArray<int64_t> counts(zone_, 64);
+  GrowableArray<int64_t> bytes(zone_, 64);
+  for (intptr_t i = 0; i < samples_->length(); i++) {
+    ProcessedSample* sample = samples_->At(i);
+    ProfileTrieNode* node = sample->timeline_trie();
+    if (node == NULL) {
+      continue;
+    }
+    RawPointerKeyValueTrait<ProfileTrieNode, intptr_t>::Pair* entry =
+        stack_index.Lookup(node);
+    intptr_t index;
+    if (entry == NULL) {
+      index = stacks.length();
+      stacks.Add(node);
+      counts.Add(0);
+      bytes.Add(0);
+      stack_index.Insert(
+          RawPointerKeyValueTrait<ProfileTrieNode, intptr_t>::Pair(node,
+                                                                   index));
+    } else {
+      index = entry->value;
+    }
+    counts[index]++;
+    bytes[index] += sample->native_allocation_size_bytes();
+  }
+
+  // Functions and locations are identified by their function table index,
+  // offset by one because pprof reserves id 0.
+  GrowableArray<bool> used_functions(zone_, functions_->length());
+  for (intptr_t i = 0; i < functions_->length(); i++) {
+    used_functions.Add(false);
+  }
+  const int64_t period_nanos =
+      static_cast<int64_t>(FLAG_profile_period) * kNanosecondsPerMicrosecond;
+  ProtobufWriter sample(zone_);
+  ProtobufWriter packed(zone_);
+  for (intptr_t i = 0; i < stacks.length(); i++) {
+    sample.Clear();
+    packed.Clear();
+    for (ProfileTrieNode* node = stacks[i]; node->parent() != NULL;
+         node = node->parent()) {
+      packed.WriteVarint(node->table_index() + 1);
+      used_functions[node->table_index()] = true;
+    }
+    sample.WriteMessage(1, packed);  // Sample.location_id
+    packed.Clear();
+    packed.WriteVarint(counts[i]);
+    if (kind == kCpuPprof) {
+      packed.WriteVarint(counts[i] * period_nanos);
+    } else if (kind == kNativeAllocationPprof) {
+      packed.WriteVarint(bytes[i]);
+    }
+    sample.WriteMessage(2, packed);  // Sample.value
+    profile.WriteMessage(2, sample);  // Profile.sample
+  }
+
+  ProtobufWriter message(zone_);
+  ProtobufWriter line(zone_);
+  Script& script = Script::Handle(zone_);
+  String& url = String::Handle(zone_);
+  for (intptr_t i = 0; i < functions_->length(); i++) {
+    if (!used_functions[i]) {
+      continue;
+    }
+    ProfileFunction* function = functions_->At(i);
+    const intptr_t id = i + 1;
+
+    message.Clear();
+    line.Clear();
+    line.WriteInt64(1, id);  // Line.function_id
+    message.WriteInt64(1, id);  // Location.id
+    message.WriteMessage(4, line);  // Location.line
+    profile.WriteMessage(4, message);  // Profile.location
+
+    message.Clear();
+    message.WriteInt64(1, id);  // Function.id
+    message.WriteInt64(2, strings.Intern(function->Name()));  // Function.name
+    const Function& dart_function = *function->function();
+    if ((function->kind() == ProfileFunction::kDartFunction) &&
+        !dart_function.IsNull()) {
+      script = dart_function.script();
+      if (!script.IsNull()) {
+        url = script.url();
+        message.WriteInt64(4, strings.Intern(url.ToCString()));
+        if (dart_function.token_pos().IsReal()) {
+          intptr_t start_line = 0;
+          intptr_t start_column = 0;
+          script.GetTokenLocation(dart_function.token_pos(), &start_line,
+                                  &start_column);
+          message.WriteInt64(5, start_line);  // Function.start_line
+        }
+      }
+    }
+    profile.WriteMessage(5, message);  // Profile.function
+  }
+
+  if (sample_count() > 0) {
+    // Profile.time_nanos and Profile.duration_nanos.
+    profile.WriteInt64(9, min_time() * kNanosecondsPerMicrosecond);
+    profile.WriteInt64(10, GetTimeSpan() * kNanosecondsPerMicrosecond);
+  }
+  if (kind == kCpuPprof) {
+    WritePprofValueType(&profile, 11, &strings, "cpu", "nanoseconds");
+    profile.WriteInt64(12, period_nanos);  // Profile.period
+  }
+
+  // Must come last, after every string has been interned.
+  strings.Write(&profile);
+
+  *length = profile.length();
+  uint8_t* result = zone_->Alloc<uint8_t>(profile.length());
+  memmove(result, profile.data(), profile.length());
+  return result;
+}
+
 ProfileFunction* Profile::FindFunction(const Function& function) {
   return (functions_ != NULL) ? functions_->Lookup(function) : NULL;
 }
@@ -2873,6 +3130,67 @@ void ProfilerService::AddToTimeline() {
                 Profiler::sample_buffer(), kAsPlatformTimeline);
 }
 
+class AllocationSampleFilter : public SampleFilter {
+ public:
+  AllocationSampleFilter(Dart_Port port,
+                         intptr_t thread_task_mask,
+                         int64_t time_origin_micros,
+                         int64_t time_extent_micros)
+      : SampleFilter(port,
+                     thread_task_mask,
+                     time_origin_micros,
+                     time_extent_micros) {}
+
+  bool FilterSample(Sample* sample) { return sample->is_allocation_sample(); }
+};
+
+bool ProfilerService::WritePprof(Profile::PprofKind kind,
+                                 int64_t time_origin_micros,
+                                 int64_t time_extent_micros,
+                                 Dart_StreamingWriteCallback callback,
+                                 void* callback_data) {
+  Thread* thread = Thread::Current();
+  Isolate* isolate = thread->isolate();
+  SampleBuffer* sample_buffer = (kind == Profile::kNativeAllocationPprof)
+                                    ? Profiler::allocation_sample_buffer()
+                                    : Profiler::sample_buffer();
+  if (sample_buffer == NULL) {
+    return false;
+  }
+
+  // Disable thread interrupts while processing the buffer.
+  DisableThreadInterruptsScope dtis(thread);
+  StackZone zone(thread);
+  HANDLESCOPE(thread);
+  NoAllocationSampleFilter cpu_filter(isolate->main_port(),
+                                      Thread::kMutatorTask, time_origin_micros,
+                                      time_extent_micros);
+  AllocationSampleFilter allocation_filter(
+      isolate->main_port(), Thread::kMutatorTask, time_origin_micros,
+      time_extent_micros);
+  NativeAllocationSampleFilter native_filter(time_origin_micros,
+                                             time_extent_micros);
+  SampleFilter* filter = NULL;
+  switch (kind) {
+    case Profile::kCpuPprof:
+      filter = &cpu_filter;
+      break;
+    case Profile::kAllocationPprof:
+      filter = &allocation_filter;
+      break;
+    case Profile::kNativeAllocationPprof:
+      filter = &native_filter;
+      break;
+  }
+
+  Profile profile(isolate);
+  profile.Build(thread, filter, sample_buffer, Profile::kNoTags);
+  intptr_t length = 0;
+  const uint8_t* bytes = profile.EncodePprof(kind, &length);
+  callback(callback_data, bytes, length);
+  return true;
+}
+
 void ProfilerService::ClearSamples() {
   SampleBuffer* sample_buffer = Profiler::sample_buffer();
   if (sample_buffer == NULL) {
@@ -372,6 +372,13 @@ class Profile : public ValueObject {
 
   static bool IsFunctionTrie(TrieKind kind) { return !IsCodeTrie(kind); }
 
+  // The values recorded per stack when encoding as pprof.
+  enum PprofKind {
+    kCpuPprof,               // Sample count and CPU time.
+    kAllocationPprof,        // Allocation sample count.
+    kNativeAllocationPprof,  // Allocation sample count and bytes.
+  };
+
   explicit Profile(Isolate* isolate);
 
   // Build a filtered model using |filter| with the specified |tag_order|.
@@ -396,6 +403,10 @@ class Profile : public ValueObject {
   void PrintProfileJSON(JSONStream* stream);
   void PrintTimelineJSON(JSONStream* stream);
 
+  // Encodes the profile as a pprof profile.proto message. Samples with the
+  // same stack are merged. The result is zone allocated.
+  const uint8_t* EncodePprof(PprofKind kind, intptr_t* length);
+
   // Serializes sample backtraces into arguments on Instant events and adds them
   // directly to the timeline.
   void AddToTimeline();
@@ -501,6 +512,14 @@ class ProfilerService : public AllStatic {
 
   static void AddToTimeline();
 
+  // Writes the samples recorded in the given time range as an uncompressed
+  // pprof profile. Returns false if the profiler is disabled.
+  static bool WritePprof(Profile::PprofKind kind,
+                         int64_t time_origin_micros,
+                         int64_t time_extent_micros,
+                         Dart_StreamingWriteCallback callback,
+                         void* callback_data);
+
   static void ClearSamples();
 
  private:
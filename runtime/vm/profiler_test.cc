@@ -343,6 +343,109 @@ ISOLATE_UNIT_TEST_CASE(Profiler_TrivialRecordAllocation) {
   }
 }
 
+static uint64_t ReadPprofVarint(const uint8_t* data, intptr_t* position) {
+  uint64_t value = 0;
+  intptr_t shift = 0;
+  uint8_t byte;
+  do {
+    byte = data[(*position)++];
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    shift += 7;
+  } while ((byte & 0x80) != 0);
+  return value;
+}
+
+// Counts the top-level fields of a pprof Profile message with the given
+// field number and checks that 'str' is in its string table.
+static intptr_t CountPprofFields(const uint8_t* data,
+                                 intptr_t length,
+                                 intptr_t field,
+                                 const char* str,
+                                 bool* found_str) {
+  const intptr_t kStringTableField = 6;
+  intptr_t count = 0;
+  intptr_t position = 0;
+  *found_str = false;
+  while (position < length) {
+    uint64_t tag = ReadPprofVarint(data, &position);
+    intptr_t field_length = 0;
+    if ((tag & 7) == 0) {
+      ReadPprofVarint(data, &position);
+    } else {
+      EXPECT_EQ(2, static_cast<intptr_t>(tag & 7));
+      field_length = ReadPprofVarint(data, &position);
+    }
+    if (static_cast<intptr_t>(tag >> 3) == field) {
+      count++;
+    }
+    if ((static_cast<intptr_t>(tag >> 3) == kStringTableField) &&
+        (field_length == static_cast<intptr_t>(strlen(str))) &&
+        (strncmp(reinterpret_cast<const char*>(data + position), str,
+                 field_length) == 0)) {
+      *found_str = true;
+    }
+    position += field_length;
+  }
+  EXPECT_EQ(length, position);
+  return count;
+}
+
+ISOLATE_UNIT_TEST_CASE(Profiler_PprofAllocation) {
+  EnableProfiler();
+  DisableNativeProfileScope dnps;
+  DisableBackgroundCompilationScope dbcs;
+  const char* kScript =
+      "class A {\n"
+      "  var a;\n"
+      "  var b;\n"
+      "}\n"
+      "class B {\n"
+      "  static boo() {\n"
+      "    return new A();\n"
+      "  }\n"
+      "}\n"
+      "main() {\n"
+      "  return B.boo();\n"
+      "}\n";
+
+  const Library& root_library = Library::Handle(LoadTestScript(kScript));
+
+  const int64_t before_allocations_micros = Dart_TimelineGetMicros();
+  const Class& class_a = Class::Handle(GetClass(root_library, "A"));
+  EXPECT(!class_a.IsNull());
+  class_a.SetTraceAllocation(true);
+
+  Invoke(root_library, "main");
+  Invoke(root_library, "main");
+
+  const int64_t after_allocations_micros = Dart_TimelineGetMicros();
+  const int64_t allocation_extent_micros =
+      after_allocations_micros - before_allocations_micros;
+  {
+    Thread* thread = Thread::Current();
+    Isolate* isolate = thread->isolate();
+    StackZone zone(thread);
+    HANDLESCOPE(thread);
+    Profile profile(isolate);
+    AllocationFilter filter(isolate->main_port(), class_a.id(),
+                            before_allocations_micros,
+                            allocation_extent_micros);
+    profile.Build(thread, &filter, Profiler::sample_buffer(), Profile::kNoTags);
+    EXPECT_EQ(2, profile.sample_count());
+
+    intptr_t length = 0;
+    const uint8_t* pprof =
+        profile.EncodePprof(Profile::kAllocationPprof, &length);
+    EXPECT(length > 0);
+    const intptr_t kSampleField = 2;
+    bool found_boo = false;
+    // Both samples have the same stack and are merged.
+    EXPECT_EQ(1, CountPprofFields(pprof, length, kSampleField, "B.boo",
+                                  &found_boo));
+    EXPECT(found_boo);
+  }
+}
+
 #if defined(DART_USE_TCMALLOC) && defined(HOST_OS_LINUX) && defined(DEBUG) &&  \
     defined(HOST_ARCH_x64)
 
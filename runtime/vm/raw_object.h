@@ -735,7 +735,8 @@ class RawObject {
   friend class StackFrame;              // GetCodeObject assertion.
   friend class CodeLookupTableBuilder;  // profiler
   friend class NativeEntry;             // GetClassId
-  friend class WritePointerVisitor;     // GetClassId
+  template <typename Stream>
+  friend class WritePointerVisitor;  // GetClassId
   friend class Interpreter;
   friend class InterpreterHelpers;
   friend class Simulator;
@@ -1238,6 +1239,7 @@ class RawKernelProgramInfo : public RawObject {
   RawGrowableObjectArray* potential_natives_;
   RawGrowableObjectArray* potential_pragma_functions_;
   RawExternalTypedData* constants_table_;
+  RawExternalTypedData* source_table_;
   RawArray* libraries_cache_;
   RawArray* classes_cache_;
   VISIT_TO(RawObject*, classes_cache_);
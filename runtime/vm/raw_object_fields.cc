@@ -94,6 +94,7 @@ namespace dart {
   F(KernelProgramInfo, potential_natives_)                                     \
   F(KernelProgramInfo, potential_pragma_functions_)                            \
   F(KernelProgramInfo, constants_table_)                                       \
+  F(KernelProgramInfo, source_table_)                                          \
   F(KernelProgramInfo, libraries_cache_)                                       \
   F(KernelProgramInfo, classes_cache_)                                         \
   F(Code, object_pool_)                                                        \
@@ -228,6 +228,11 @@ static void EnsureNewOrRemembered(Thread* thread, const Object& result) {
   RawObject* object = result.raw();
   if (!object->IsNewObject()) {
     object->AddToRememberedSet(thread);
+    // Stores into the object may also skip the incremental marking barrier,
+    // so have the marker revisit it once the stores have been performed.
+    if (thread->is_marking()) {
+      thread->DeferredMarkingStackAddObject(object);
+    }
   }
 }
 
@@ -293,8 +298,10 @@ static TokenPosition GetCallerLocation() {
 // Return value: newly allocated object.
 DEFINE_RUNTIME_ENTRY(AllocateObject, 2) {
   const Class& cls = Class::CheckedHandle(zone, arguments.ArgAt(0));
-  const Instance& instance =
-      Instance::Handle(zone, Instance::New(cls, Heap::kNew));
+  const Heap::Space space =
+      isolate->heap()->new_space()->IsPretenured(cls.id()) ? Heap::kOld
+                                                           : Heap::kNew;
+  const Instance& instance = Instance::Handle(zone, Instance::New(cls, space));
 
   arguments.SetReturn(instance);
   if (cls.NumTypeArguments() == 0) {
@@ -2160,6 +2167,105 @@ DEFINE_RUNTIME_ENTRY(OptimizeInvokedFunction, 1) {
 #endif  // !DART_PRECOMPILED_RUNTIME
 }
 
+#if !defined(DART_PRECOMPILED_RUNTIME) && !defined(DART_PRECOMPILER)
+static int LowestFirst(const intptr_t* a, const intptr_t* b) {
+  return *a - *b;
+}
+
+// Returns the deopt id of the OSR entry that [unoptimized_code] has for the
+// loop stack check at [check_index] in [bytecode], or DeoptId::kNone.
+// The bytecode flow graph builder allocates deopt ids in bytecode order, so
+// the n-th loop CheckStack has the n-th lowest OSR entry deopt id.
+static intptr_t GetDeoptIdForBytecodeOsr(const Bytecode& bytecode,
+                                         intptr_t check_index,
+                                         const Code& unoptimized_code) {
+  const KBCInstr* instrs =
+      reinterpret_cast<const KBCInstr*>(bytecode.PayloadStart());
+  const intptr_t num_instrs = bytecode.Size() / sizeof(KBCInstr);
+  intptr_t num_loop_checks = 0;
+  intptr_t loop_check = -1;
+  for (intptr_t i = 0; i < num_instrs; i++) {
+    if ((KernelBytecode::DecodeOpcode(instrs[i]) ==
+         KernelBytecode::kCheckStack) &&
+        (KernelBytecode::DecodeA(instrs[i]) > 0)) {
+      if (i == check_index) {
+        loop_check = num_loop_checks;
+      }
+      num_loop_checks++;
+    }
+  }
+  ASSERT(loop_check >= 0);
+
+  GrowableArray<intptr_t> osr_ids;
+  PcDescriptors::Iterator iter(
+      PcDescriptors::Handle(unoptimized_code.pc_descriptors()),
+      RawPcDescriptors::kOsrEntry);
+  while (iter.MoveNext()) {
+    osr_ids.Add(iter.DeoptId());
+  }
+  // The unoptimized code was not compiled from this bytecode, or some loop
+  // stack check was not compiled.
+  if (osr_ids.length() != num_loop_checks) {
+    return DeoptId::kNone;
+  }
+  osr_ids.Sort(LowestFirst);
+  return osr_ids[loop_check];
+}
+#endif  // !defined(DART_PRECOMPILED_RUNTIME) && !defined(DART_PRECOMPILER)
+
+// Compiles optimized code entered at a loop stack check of an interpreted
+// function, for the interpreter to continue the running activation in.
+// Arg0: function.
+// Arg1: index of the CheckStack instruction in the function's bytecode.
+// Returns the OSR code, or null if the activation stays interpreted.
+DEFINE_RUNTIME_ENTRY(CompileInterpretedFunctionForOsr, 2) {
+#if !defined(DART_PRECOMPILED_RUNTIME) && !defined(DART_PRECOMPILER)
+  const Function& function = Function::CheckedHandle(zone, arguments.ArgAt(0));
+  const Smi& check_index = Smi::CheckedHandle(zone, arguments.ArgAt(1));
+  ASSERT(FLAG_enable_interpreter && isolate->use_osr());
+  arguments.SetReturn(Object::null_object());
+
+  // The OSR entry is found through the unoptimized code, which is also what
+  // optimized code deoptimizes to. Intrinsic code can't be entered via OSR.
+  if (!function.HasCode() || (function.unoptimized_code() == Code::null()) ||
+      !function.HasBytecode() || function.is_intrinsic() ||
+      !Compiler::CanOptimizeFunction(thread, function)) {
+    // Bump the usage counter down to avoid re-entering the runtime on every
+    // back-edge.
+    function.SetUsageCounter(0);
+    return;
+  }
+  const Code& unoptimized_code =
+      Code::Handle(zone, function.unoptimized_code());
+  const intptr_t osr_id = GetDeoptIdForBytecodeOsr(
+      Bytecode::Handle(zone, function.bytecode()), check_index.Value(),
+      unoptimized_code);
+  if (osr_id == DeoptId::kNone) {
+    function.SetUsageCounter(0);
+    return;
+  }
+  if (FLAG_trace_osr) {
+    OS::PrintErr("Attempting OSR of interpreted %s at id=%" Pd
+                 ", count=%" Pd "\n",
+                 function.ToFullyQualifiedCString(), osr_id,
+                 function.usage_counter());
+  }
+
+  const Object& result = Object::Handle(
+      zone, Compiler::CompileOptimizedFunction(thread, function, osr_id));
+  ThrowIfError(result);
+  if (result.IsNull()) {
+    function.SetUsageCounter(0);
+    return;
+  }
+  arguments.SetReturn(result);
+#else
+  // The interpreter reads the frame size of the OSR code from
+  // Code::variables(), which only JIT configurations record.
+  UNREACHABLE();
+#endif  // !defined(DART_PRECOMPILED_RUNTIME) && !defined(DART_PRECOMPILER)
+}
+
 // The caller must be a static call in a Dart frame, or an entry frame.
 // Patch static call to point to valid code's entry point.
 DEFINE_RUNTIME_ENTRY(FixCallersTarget, 0) {
@@ -870,6 +870,100 @@ VM_UNIT_TEST_CASE(FullSnapshot1) {
   free(isolate_snapshot_data_buffer);
 }
 
+VM_UNIT_TEST_CASE(FullSnapshotConcurrentFill) {
+  // Force the fill of every cluster that allows it onto helper tasks, however
+  // small the snapshot is.
+  SetFlagScope<int> sfs(&FLAG_deserializer_tasks, 4);
+  SetFlagScope<int> sfs2(&FLAG_deserializer_min_concurrent_fill_kb, 0);
+
+  const char* kScriptChars =
+      "class Node {\n"
+      "  Node(this.id, this.name, this.next);\n"
+      "  final int id;\n"
+      "  final String name;\n"
+      "  final Node next;\n"
+      "}\n"
+      "class Data {\n"
+      "  static List strings;\n"
+      "  static List<double> doubles;\n"
+      "  static List<int> mints;\n"
+      "  static List<List<int>> lists;\n"
+      "  static Node nodes;\n"
+      "  static void init() {\n"
+      "    strings = new List.generate(2000, (i) => 'string $i');\n"
+      "    doubles = new List.generate(2000, (i) => i + 0.5);\n"
+      "    mints = new List.generate(2000, (i) => 0x100000000000 + i);\n"
+      "    lists = new List.generate(200, (i) => new List.filled(i, i));\n"
+      "    for (int i = 0; i < 2000; i++) {\n"
+      "      nodes = new Node(i, 'node $i', nodes);\n"
+      "    }\n"
+      "  }\n"
+      "  static int check() {\n"
+      "    for (int i = 0; i < 2000; i++) {\n"
+      "      if (strings[i] != 'string $i') return 1;\n"
+      "      if (doubles[i] != i + 0.5) return 2;\n"
+      "      if (mints[i] != 0x100000000000 + i) return 3;\n"
+      "    }\n"
+      "    for (int i = 0; i < 200; i++) {\n"
+      "      if (lists[i].length != i) return 4;\n"
+      "      for (final e in lists[i]) {\n"
+      "        if (e != i) return 5;\n"
+      "      }\n"
+      "    }\n"
+      "    Node node = nodes;\n"
+      "    for (int i = 1999; i >= 0; i--) {\n"
+      "      if (node.id != i || node.name != 'node $i') return 6;\n"
+      "      node = node.next;\n"
+      "    }\n"
+      "    if (node != null) return 7;\n"
+      "    return 0;\n"
+      "  }\n"
+      "}\n";
+
+  uint8_t* isolate_snapshot_data_buffer;
+
+  // Start an Isolate, load a script, fill the heap and create a full
+  // snapshot.
+  {
+    TestIsolateScope __test_isolate__;
+
+    Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+    EXPECT_VALID(lib);
+    Dart_Handle cls = Dart_GetClass(lib, NewString("Data"));
+    EXPECT_VALID(Dart_Invoke(cls, NewString("init"), 0, NULL));
+
+    Thread* thread = Thread::Current();
+    TransitionNativeToVM transition(thread);
+    StackZone zone(thread);
+    HandleScope scope(thread);
+    Dart_Handle result = Api::CheckAndFinalizePendingClasses(thread);
+    {
+      TransitionVMToNative to_native(thread);
+      EXPECT_VALID(result);
+    }
+    FullSnapshotWriter writer(Snapshot::kFull, NULL,
+                              &isolate_snapshot_data_buffer, &malloc_allocator,
+                              NULL, /*image_writer*/ nullptr);
+    writer.WriteFullSnapshot();
+  }
+
+  // Read the snapshot back, filling on the helper tasks, and check that the
+  // data reachable from the statics survived.
+  TestCase::CreateTestIsolateFromSnapshot(isolate_snapshot_data_buffer);
+  {
+    Dart_EnterScope();
+    Dart_Handle cls = Dart_GetClass(TestCase::lib(), NewString("Data"));
+    Dart_Handle result = Dart_Invoke(cls, NewString("check"), 0, NULL);
+    EXPECT_VALID(result);
+    int64_t value = -1;
+    EXPECT_VALID(Dart_IntegerToInt64(result, &value));
+    EXPECT_EQ(0, value);
+    Dart_ExitScope();
+  }
+  Dart_ShutdownIsolate();
+  free(isolate_snapshot_data_buffer);
+}
+
 // Helper function to call a top level Dart function and serialize the result.
 static Message* GetSerialized(Dart_Handle lib, const char* dart_function) {
   Dart_Handle result;
@@ -121,6 +121,13 @@ bool StubCode::InInvocationStub(uword pc, bool is_interpreted_frame) {
         return true;
       }
     }
+    {
+      uword entry = StubCode::InvokeDartOsrCodeFromBytecode().EntryPoint();
+      uword size = StubCode::InvokeDartOsrCodeFromBytecodeSize();
+      if ((pc >= entry) && (pc < (entry + size))) {
+        return true;
+      }
+    }
   }
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
   uword entry = StubCode::InvokeDartCode().EntryPoint();
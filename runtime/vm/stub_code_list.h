@@ -32,6 +32,7 @@ namespace dart {
   V(OptimizeFunction)                                                          \
   V(InvokeDartCode)                                                            \
   V(InvokeDartCodeFromBytecode)                                                \
+  V(InvokeDartOsrCodeFromBytecode)                                             \
   V(DebugStepCheck)                                                            \
   V(UnlinkedCall)                                                              \
   V(MonomorphicMiss)                                                           \
@@ -97,6 +98,7 @@ namespace dart {
   V(FrameAwaitingMaterialization)                                              \
   V(AsynchronousGapMarker)                                                     \
   V(InvokeDartCodeFromBytecode)                                                \
+  V(InvokeDartOsrCodeFromBytecode)                                             \
   V(InterpretCall)
 
 #endif  // !defined(TARGET_ARCH_DBC)
@@ -101,6 +101,8 @@ class Zone;
   V(RawCode*, invoke_dart_code_stub_, StubCode::InvokeDartCode().raw(), NULL)  \
   V(RawCode*, invoke_dart_code_from_bytecode_stub_,                            \
     StubCode::InvokeDartCodeFromBytecode().raw(), NULL)                        \
+  V(RawCode*, invoke_dart_osr_code_from_bytecode_stub_,                        \
+    StubCode::InvokeDartOsrCodeFromBytecode().raw(), NULL)                     \
   V(RawCode*, call_to_runtime_stub_, StubCode::CallToRuntime().raw(), NULL)    \
   V(RawCode*, null_error_shared_without_fpu_regs_stub_,                        \
     StubCode::NullErrorSharedWithoutFPURegs().raw(), NULL)                     \
@@ -6,9 +6,16 @@
 
 #include "platform/assert.h"
 #include "platform/utils.h"
+#include "vm/flags.h"
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            huge_pages,
+            false,
+            "Back the Dart heap with transparent huge pages where the OS "
+            "supports them.");
+
 bool VirtualMemory::InSamePage(uword address0, uword address1) {
   return (Utils::RoundDown(address0, PageSize()) ==
           Utils::RoundDown(address1, PageSize()));
@@ -17,8 +24,8 @@ bool VirtualMemory::InSamePage(uword address0, uword address1) {
 void VirtualMemory::Truncate(intptr_t new_size) {
   ASSERT(Utils::IsAligned(new_size, PageSize()));
   ASSERT(new_size <= size());
-  if (reserved_.size() ==
-      region_.size()) {  // Don't create holes in reservation.
+  // Don't create holes in reservation or in a huge page.
+  if ((reserved_.size() == region_.size()) && !from_huge_page_pool_) {
     FreeSubSegment(reinterpret_cast<void*>(start() + new_size),
                    size() - new_size);
     reserved_.set_size(new_size);
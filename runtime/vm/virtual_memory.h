@@ -31,6 +31,7 @@ class VirtualMemory {
   intptr_t AliasOffset() const { return alias_.start() - region_.start(); }
 
   static void Init();
+  static void Cleanup();
 
   bool Contains(uword addr) const { return region_.Contains(addr); }
   bool ContainsAlias(uword addr) const {
@@ -41,6 +42,11 @@ class VirtualMemory {
   static void Protect(void* address, intptr_t size, Protection mode);
   void Protect(Protection mode) { return Protect(address(), size(), mode); }
 
+  // Returns the physical memory backing this segment to the OS while keeping
+  // the address range reserved and accessible. Until it is written again, the
+  // memory reads as zero or as its previous contents.
+  void Decommit();
+
   // Reserves and commits a virtual memory segment with size. If a segment of
   // the requested size cannot be allocated, NULL is returned.
   static VirtualMemory* Allocate(intptr_t size,
@@ -69,6 +75,10 @@ class VirtualMemory {
   // protection status changed by the VM.
   bool vm_owns_region() const { return reserved_.pointer() != NULL; }
 
+  // True for a block of a huge-page segment. Decommitting it would split the
+  // huge page backing it.
+  bool from_huge_page_pool() const { return from_huge_page_pool_; }
+
   static VirtualMemory* ForImagePage(void* pointer, uword size);
 
  private:
@@ -81,10 +91,16 @@ class VirtualMemory {
   VirtualMemory(const MemoryRegion& region,
                 const MemoryRegion& alias,
                 const MemoryRegion& reserved)
-      : region_(region), alias_(alias), reserved_(reserved) {}
+      : region_(region),
+        alias_(alias),
+        reserved_(reserved),
+        from_huge_page_pool_(false) {}
 
   VirtualMemory(const MemoryRegion& region, const MemoryRegion& reserved)
-      : region_(region), alias_(region), reserved_(reserved) {}
+      : region_(region),
+        alias_(region),
+        reserved_(reserved),
+        from_huge_page_pool_(false) {}
 
   MemoryRegion region_;
 
@@ -97,6 +113,10 @@ class VirtualMemory {
   // Its size might disagree with region_ due to Truncate.
   MemoryRegion reserved_;
 
+  // Whether reserved_ is a block of a huge-page segment, which is returned to
+  // its pool rather than unmapped.
+  bool from_huge_page_pool_;
+
   static uword page_size_;
 
 #if defined(HOST_OS_FUCHSIA)
@@ -57,6 +57,8 @@ void VirtualMemory::Init() {
   base_ = buf[0].base;
 }
 
+void VirtualMemory::Cleanup() {}
+
 static void Unmap(zx_handle_t vmar, uword start, uword end) {
   ASSERT(start <= end);
   const uword size = end - start;
@@ -199,6 +201,10 @@ void VirtualMemory::FreeSubSegment(void* address, intptr_t size) {
   LOG_INFO("zx_vmar_unmap(0x%p, 0x%lx) success\n", address, size);
 }
 
+void VirtualMemory::Decommit() {
+  // Not supported: the memory stays committed until the segment is unmapped.
+}
+
 void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
 #if defined(DEBUG)
   Thread* thread = Thread::Current();
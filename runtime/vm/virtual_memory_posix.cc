@@ -16,7 +16,9 @@
 
 #include "platform/assert.h"
 #include "platform/utils.h"
+#include "vm/growable_array.h"
 #include "vm/isolate.h"
+#include "vm/lockers.h"
 
 // #define VIRTUAL_MEMORY_LOGGING 1
 #if defined(VIRTUAL_MEMORY_LOGGING)
@@ -33,13 +35,30 @@ namespace dart {
 #define MAP_FAILED reinterpret_cast<void*>(-1)
 
 DECLARE_FLAG(bool, dual_map_code);
+DECLARE_FLAG(bool, huge_pages);
 DECLARE_FLAG(bool, write_protect_code);
 
+#if defined(HOST_OS_LINUX) && defined(MADV_HUGEPAGE)
+#define HUGE_PAGES_SUPPORTED
+#endif
+
 uword VirtualMemory::page_size_ = 0;
 
+#if defined(HUGE_PAGES_SUPPORTED)
+// Size of a transparent huge page on x86 and ARM64 Linux.
+static const intptr_t kHugePageSize = 2 * MB;
+
+static void InitHugePagePools();
+static void CleanupHugePagePools();
+#endif  // defined(HUGE_PAGES_SUPPORTED)
+
 void VirtualMemory::Init() {
   page_size_ = getpagesize();
 
+#if defined(HUGE_PAGES_SUPPORTED)
+  InitHugePagePools();
+#endif  // defined(HUGE_PAGES_SUPPORTED)
+
 #if defined(DUAL_MAPPING_SUPPORTED)
   // Detect dual mapping exec permission limitation on some platforms,
   // such as on docker containers, and disable dual mapping in this case.
@@ -66,6 +85,12 @@ void VirtualMemory::Init() {
 #endif  // defined(DUAL_MAPPING_SUPPORTED)
 }
 
+void VirtualMemory::Cleanup() {
+#if defined(HUGE_PAGES_SUPPORTED)
+  CleanupHugePagePools();
+#endif  // defined(HUGE_PAGES_SUPPORTED)
+}
+
 static void unmap(uword start, uword end) {
   ASSERT(start <= end);
   uword size = end - start;
@@ -82,6 +107,154 @@ static void unmap(uword start, uword end) {
   }
 }
 
+static void* MapAnonymousAligned(intptr_t size, intptr_t alignment, int prot) {
+  const intptr_t allocated_size = size + alignment - VirtualMemory::PageSize();
+  void* address =
+      mmap(NULL, allocated_size, prot, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  LOG_INFO("mmap(NULL, 0x%" Px ", %u, ...): %p\n", allocated_size, prot,
+           address);
+  if (address == MAP_FAILED) {
+    return NULL;
+  }
+
+  const uword base = reinterpret_cast<uword>(address);
+  const uword aligned_base = Utils::RoundUp(base, alignment);
+
+  unmap(base, aligned_base);
+  unmap(aligned_base + size, base + allocated_size);
+  return reinterpret_cast<void*>(aligned_base);
+}
+
+#if defined(HUGE_PAGES_SUPPORTED)
+static void AdviseHugePages(void* address, intptr_t size) {
+  if (madvise(address, size, MADV_HUGEPAGE) != 0) {
+    // Transparent huge pages are disabled; the memory is still usable.
+    LOG_INFO("madvise(%p, 0x%" Px ", MADV_HUGEPAGE) failed\n", address, size);
+  }
+}
+
+// Heap pages are much smaller than a huge page, and mapping them one by one
+// leaves nothing for the kernel to back with huge pages. Instead, blocks of
+// one size are carved out of huge-page aligned segments. Freed blocks are
+// kept for reuse, and a segment is unmapped once all of its blocks are free,
+// so that unmapping a block never splits a huge page. Reused blocks are not
+// cleared.
+class HugePagePool {
+ public:
+  explicit HugePagePool(int prot)
+      : prot_(prot), block_size_(0), segments_(), free_blocks_() {}
+
+  // Unmaps all segments, including blocks that are still in use.
+  ~HugePagePool() {
+    for (intptr_t i = 0; i < segments_.length(); i++) {
+      unmap(segments_[i].base, segments_[i].base + kHugePageSize);
+    }
+  }
+
+  // Returns 0 if 'size' is not pooled or no memory is available.
+  uword Allocate(intptr_t size) {
+    MutexLocker ml(&mutex_);
+    if (block_size_ == 0) {
+      block_size_ = size;
+    } else if (size != block_size_) {
+      return 0;
+    }
+    if (free_blocks_.is_empty() && !AddSegment()) {
+      return 0;
+    }
+    const uword block = free_blocks_.RemoveLast();
+    Segment* segment = FindSegment(block);
+    ASSERT(segment != NULL);
+    segment->num_free--;
+    return block;
+  }
+
+  // Returns false if 'block' does not belong to this pool.
+  bool Free(uword block) {
+    MutexLocker ml(&mutex_);
+    Segment* segment = FindSegment(block);
+    if (segment == NULL) {
+      return false;
+    }
+    segment->num_free++;
+    free_blocks_.Add(block);
+    if (segment->num_free == kHugePageSize / block_size_) {
+      RemoveSegment(segment);
+    }
+    return true;
+  }
+
+ private:
+  struct Segment {
+    uword base;
+    intptr_t num_free;
+  };
+
+  bool AddSegment() {
+    void* address = MapAnonymousAligned(kHugePageSize, kHugePageSize, prot_);
+    if (address == NULL) {
+      return false;
+    }
+    AdviseHugePages(address, kHugePageSize);
+    Segment segment;
+    segment.base = reinterpret_cast<uword>(address);
+    segment.num_free = kHugePageSize / block_size_;
+    segments_.Add(segment);
+    for (intptr_t i = segment.num_free - 1; i >= 0; i--) {
+      free_blocks_.Add(segment.base + i * block_size_);
+    }
+    return true;
+  }
+
+  void RemoveSegment(Segment* segment) {
+    const uword base = segment->base;
+    for (intptr_t i = free_blocks_.length() - 1; i >= 0; i--) {
+      if (Utils::RoundDown(free_blocks_[i], kHugePageSize) == base) {
+        free_blocks_.RemoveAt(i);
+      }
+    }
+    *segment = segments_.RemoveLast();
+    unmap(base, base + kHugePageSize);
+  }
+
+  Segment* FindSegment(uword block) {
+    const uword base = Utils::RoundDown(block, kHugePageSize);
+    for (intptr_t i = 0; i < segments_.length(); i++) {
+      if (segments_[i].base == base) {
+        return &segments_[i];
+      }
+    }
+    return NULL;
+  }
+
+  Mutex mutex_;
+  const int prot_;
+  intptr_t block_size_;
+  MallocGrowableArray<Segment> segments_;
+  MallocGrowableArray<uword> free_blocks_;
+
+  DISALLOW_COPY_AND_ASSIGN(HugePagePool);
+};
+
+static HugePagePool* data_huge_page_pool = NULL;
+static HugePagePool* code_huge_page_pool = NULL;
+
+static void InitHugePagePools() {
+  if (data_huge_page_pool == NULL) {
+    data_huge_page_pool = new HugePagePool(PROT_READ | PROT_WRITE);
+    code_huge_page_pool =
+        new HugePagePool(PROT_READ | PROT_WRITE | PROT_EXEC);
+  }
+}
+
+static void CleanupHugePagePools() {
+  delete data_huge_page_pool;
+  data_huge_page_pool = NULL;
+  delete code_huge_page_pool;
+  code_huge_page_pool = NULL;
+}
+#endif  // defined(HUGE_PAGES_SUPPORTED)
+
 #if defined(DUAL_MAPPING_SUPPORTED)
 // Do not leak file descriptors to child processes.
 #if !defined(MFD_CLOEXEC)
@@ -142,8 +315,8 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
   ASSERT(Utils::IsAligned(size, page_size_));
   ASSERT(Utils::IsPowerOfTwo(alignment));
   ASSERT(Utils::IsAligned(alignment, page_size_));
-  const intptr_t allocated_size = size + alignment - page_size_;
 #if defined(DUAL_MAPPING_SUPPORTED)
+  const intptr_t allocated_size = size + alignment - page_size_;
   int fd = -1;
   const bool dual_mapping =
       is_executable && FLAG_write_protect_code && FLAG_dual_map_code;
@@ -182,25 +355,54 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
   const int prot =
       PROT_READ | PROT_WRITE |
       ((is_executable && !FLAG_write_protect_code) ? PROT_EXEC : 0);
-  void* address =
-      mmap(NULL, allocated_size, prot, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-  LOG_INFO("mmap(NULL, 0x%" Px ", %u, ...): %p\n", allocated_size, prot,
-           address);
-  if (address == MAP_FAILED) {
+#if defined(HUGE_PAGES_SUPPORTED)
+  // Write-protecting code would split huge pages, so code is only backed by
+  // them when it stays writable.
+  if (FLAG_huge_pages && (!is_executable || !FLAG_write_protect_code)) {
+    if ((size == alignment) && (alignment > PageSize()) &&
+        (size < kHugePageSize) && Utils::IsAligned(kHugePageSize, size)) {
+      HugePagePool* pool =
+          is_executable ? code_huge_page_pool : data_huge_page_pool;
+      const uword block = pool->Allocate(size);
+      if (block != 0) {
+        MemoryRegion region(reinterpret_cast<void*>(block), size);
+        VirtualMemory* result = new VirtualMemory(region, region);
+        result->from_huge_page_pool_ = true;
+        return result;
+      }
+    } else if (size >= kHugePageSize) {
+      void* address = MapAnonymousAligned(
+          size, Utils::Maximum(alignment, kHugePageSize), prot);
+      if (address == NULL) {
+        return NULL;
+      }
+      AdviseHugePages(address, size);
+      MemoryRegion region(address, size);
+      return new VirtualMemory(region, region);
+    }
+  }
+#endif  // defined(HUGE_PAGES_SUPPORTED)
+  void* address = MapAnonymousAligned(size, alignment, prot);
+  if (address == NULL) {
     return NULL;
   }
-
-  const uword base = reinterpret_cast<uword>(address);
-  const uword aligned_base = Utils::RoundUp(base, alignment);
-
-  unmap(base, aligned_base);
-  unmap(aligned_base + size, base + allocated_size);
-
-  MemoryRegion region(reinterpret_cast<void*>(aligned_base), size);
+  MemoryRegion region(address, size);
   return new VirtualMemory(region, region);
 }
 
 VirtualMemory::~VirtualMemory() {
+#if defined(HUGE_PAGES_SUPPORTED)
+  if (from_huge_page_pool_) {
+    if (data_huge_page_pool == NULL) {
+      return;  // The segment was unmapped by VirtualMemory::Cleanup.
+    }
+    if (!data_huge_page_pool->Free(reserved_.start())) {
+      const bool freed = code_huge_page_pool->Free(reserved_.start());
+      ASSERT(freed);
+    }
+    return;
+  }
+#endif  // defined(HUGE_PAGES_SUPPORTED)
   if (vm_owns_region()) {
     unmap(reserved_.start(), reserved_.end());
     const intptr_t alias_offset = AliasOffset();
@@ -216,6 +418,20 @@ void VirtualMemory::FreeSubSegment(void* address,
   unmap(start, start + size);
 }
 
+void VirtualMemory::Decommit() {
+#if defined(MADV_FREE)
+  // Lazily reclaimed, so cheaper than MADV_DONTNEED if the memory is reused
+  // before the OS is short of memory.
+  if (madvise(address(), size(), MADV_FREE) == 0) {
+    return;
+  }
+#endif
+  if (madvise(address(), size(), MADV_DONTNEED) != 0) {
+    LOG_INFO("madvise(%p, 0x%" Px ", MADV_DONTNEED) failed\n", address(),
+             size());
+  }
+}
+
 void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
 #if defined(DEBUG)
   Thread* thread = Thread::Current();
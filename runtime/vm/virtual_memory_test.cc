@@ -9,6 +9,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, huge_pages);
+
 bool IsZero(char* begin, char* end) {
   for (char* current = begin; current < end; ++current) {
     if (*current != 0) {
@@ -88,4 +90,37 @@ VM_UNIT_TEST_CASE(FreeVirtualMemory) {
   }
 }
 
+VM_UNIT_TEST_CASE(AllocateHugePageBackedVirtualMemory) {
+  const bool saved_huge_pages = FLAG_huge_pages;
+  FLAG_huge_pages = true;
+  // Enough heap pages to span several huge pages.
+  const intptr_t kNumPages = 20;
+  VirtualMemory* pages[kNumPages];
+  for (intptr_t i = 0; i < kNumPages; i++) {
+    pages[i] = VirtualMemory::AllocateAligned(kPageSize, kPageSize, false,
+                                              NULL);
+    EXPECT(pages[i] != NULL);
+    EXPECT(Utils::IsAligned(pages[i]->start(), kPageSize));
+    EXPECT_EQ(kPageSize, pages[i]->size());
+    memset(pages[i]->address(), i, kPageSize);
+  }
+  for (intptr_t i = 0; i < kNumPages; i++) {
+    uint8_t* buf = reinterpret_cast<uint8_t*>(pages[i]->address());
+    EXPECT_EQ(i, buf[0]);
+    EXPECT_EQ(i, buf[kPageSize - 1]);
+  }
+  for (intptr_t i = 0; i < kNumPages; i++) {
+    delete pages[i];
+  }
+
+  const intptr_t kNewSpaceSize = 4 * MB;
+  VirtualMemory* vm = VirtualMemory::Allocate(kNewSpaceSize, false, NULL);
+  EXPECT(vm != NULL);
+  EXPECT_EQ(kNewSpaceSize, vm->size());
+  char* buf = reinterpret_cast<char*>(vm->address());
+  EXPECT(IsZero(buf, buf + vm->size()));
+  delete vm;
+  FLAG_huge_pages = saved_huge_pages;
+}
+
 }  // namespace dart
@@ -24,6 +24,8 @@ void VirtualMemory::Init() {
   page_size_ = info.dwPageSize;
 }
 
+void VirtualMemory::Cleanup() {}
+
 VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
                                               intptr_t alignment,
                                               bool is_executable,
@@ -76,6 +78,12 @@ void VirtualMemory::FreeSubSegment(void* address,
   }
 }
 
+void VirtualMemory::Decommit() {
+  // MEM_RESET keeps the pages committed but lets the OS discard their
+  // contents instead of writing them to the paging file.
+  VirtualAlloc(address(), size(), MEM_RESET, PAGE_READWRITE);
+}
+
 void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
 #if defined(DEBUG)
   Thread* thread = Thread::Current();